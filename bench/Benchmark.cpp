@@ -0,0 +1,377 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include "CPhysics.hpp"
+#include "CLevel.hpp"
+#include "CEnemy.hpp"
+#include "CRandom.hpp"
+#include "CTextureCache.hpp"
+#include "CTextureAtlas.hpp"
+
+// ===============================================
+// Microbenchmarks de Castelvania
+// ===============================================
+// Uso: ./castelvania_bench [--quick] [--out archivo.json] [--no-textures]
+// Cada caso se repite varias veces y se guardan las muestras por iteración;
+// el informe JSON incluye media, mínimo, mediana y p99 en microsegundos.
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    const float TICK = 1.0f / 60.0f;
+    const uint32_t BENCH_SEED = 12345;
+
+    struct BenchResult {
+        std::string name;
+        int count;                    // N (cuerpos, enemigos...)
+        int iterations;
+        double meanUs;
+        double minUs;
+        double medianUs;
+        double p99Us;
+        bool skipped;
+        std::string note;
+    };
+
+    struct BenchConfig {
+        std::vector<int> sizes;
+        int iterations;
+        int warmup;
+    };
+
+    double elapsedUs(BenchClock::time_point start, BenchClock::time_point end) {
+        return std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+    BenchResult summarize(const std::string& name, int count, std::vector<double> samples) {
+        BenchResult result{name, count, static_cast<int>(samples.size()), 0.0, 0.0, 0.0, 0.0, false, ""};
+        if (samples.empty()) {
+            return result;
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        double total = 0.0;
+        for (double sample : samples) {
+            total += sample;
+        }
+
+        size_t p99Index = std::min(samples.size() - 1, (samples.size() * 99) / 100);
+
+        result.meanUs = total / samples.size();
+        result.minUs = samples.front();
+        result.medianUs = samples[samples.size() / 2];
+        result.p99Us = samples[p99Index];
+        return result;
+    }
+
+    BenchResult skippedResult(const std::string& name, int count, const std::string& note) {
+        BenchResult result{name, count, 0, 0.0, 0.0, 0.0, 0.0, true, note};
+        return result;
+    }
+
+    // Ejecuta warmup + iterations llamadas y devuelve las muestras medidas
+    std::vector<double> measure(const BenchConfig& config, const std::function<void()>& body) {
+        for (int i = 0; i < config.warmup; i++) {
+            body();
+        }
+
+        std::vector<double> samples;
+        samples.reserve(config.iterations);
+        for (int i = 0; i < config.iterations; i++) {
+            auto start = BenchClock::now();
+            body();
+            samples.push_back(elapsedUs(start, BenchClock::now()));
+        }
+        return samples;
+    }
+
+    // Nivel 1 con N enemigos repartidos en rejilla sobre el suelo
+    std::unique_ptr<CLevel> createPopulatedLevel(CPhysics* physics, int enemyCount) {
+        auto level = std::make_unique<CLevel>(1);
+        if (physics) {
+            level->initializePhysics(physics);
+        }
+        level->loadLevel();
+
+        const EnemyType types[] = {EnemyType::ZOMBIE, EnemyType::ESQUELETO, EnemyType::MURCIELAGO};
+        for (int i = 0; i < enemyCount; i++) {
+            float x = 50.0f + (i % 40) * 18.0f;
+            float y = 100.0f + (i / 40) * 12.0f;
+            level->addEnemy(types[i % 3], x, y);
+        }
+        return level;
+    }
+
+    // CASOS
+    BenchResult benchPhysicsUpdate(const BenchConfig& config, int bodyCount) {
+        CPhysics physics;
+        physics.setFixedTimestep(60.0f, 1);
+        physics.createPlatform(400.0f, 580.0f, 2000.0f, 40.0f);
+
+        for (int i = 0; i < bodyCount; i++) {
+            float x = 20.0f + (i % 50) * 15.0f;
+            float y = 50.0f + (i / 50) * 15.0f;
+            physics.createEnemyBody(x, y);
+        }
+
+        // deltaTime == paso fijo: exactamente un b2World::Step por llamada
+        std::vector<double> samples = measure(config, [&physics]() {
+            physics.update(TICK);
+        });
+        return summarize("physics_update", bodyCount, samples);
+    }
+
+    BenchResult benchUpdateEnemies(const BenchConfig& config, int enemyCount) {
+        CPhysics physics;
+        physics.setFixedTimestep(60.0f, 1);
+        CRandom::getGlobal().setSeed(BENCH_SEED);
+
+        auto level = createPopulatedLevel(&physics, enemyCount);
+        sf::Vector2f playerPosition(400.0f, 300.0f);
+
+        std::vector<double> samples = measure(config, [&level, &playerPosition]() {
+            level->updateEnemies(TICK, playerPosition);
+        });
+        return summarize("level_update_enemies", enemyCount, samples);
+    }
+
+    BenchResult benchClosestEnemy(const BenchConfig& config, int enemyCount) {
+        CRandom::getGlobal().setSeed(BENCH_SEED);
+        auto level = createPopulatedLevel(nullptr, enemyCount);
+
+        // Consultas en posiciones pseudoaleatorias fijas para que el resultado sea comparable
+        CRandom queryRandom(BENCH_SEED);
+        const int QUERIES_PER_ITERATION = 64;
+        std::vector<sf::Vector2f> queries;
+        for (int i = 0; i < QUERIES_PER_ITERATION; i++) {
+            queries.emplace_back(queryRandom.nextFloat() * 800.0f, queryRandom.nextFloat() * 600.0f);
+        }
+
+        size_t found = 0;
+        std::vector<double> samples = measure(config, [&level, &queries, &found]() {
+            for (const sf::Vector2f& query : queries) {
+                if (level->getClosestEnemyToPosition(query, 200.0f)) {
+                    found++;
+                }
+            }
+        });
+
+        BenchResult result = summarize("level_closest_enemy_x64", enemyCount, samples);
+        result.note = "hits=" + std::to_string(found);
+        return result;
+    }
+
+    BenchResult benchEnemiesInRadius(const BenchConfig& config, int enemyCount) {
+        CRandom::getGlobal().setSeed(BENCH_SEED);
+        auto level = createPopulatedLevel(nullptr, enemyCount);
+
+        CRandom queryRandom(BENCH_SEED);
+        const int QUERIES_PER_ITERATION = 64;
+        std::vector<sf::Vector2f> queries;
+        for (int i = 0; i < QUERIES_PER_ITERATION; i++) {
+            queries.emplace_back(queryRandom.nextFloat() * 800.0f, queryRandom.nextFloat() * 600.0f);
+        }
+
+        std::vector<CEnemy*> inRange;
+        size_t found = 0;
+        std::vector<double> samples = measure(config, [&level, &queries, &inRange, &found]() {
+            for (const sf::Vector2f& query : queries) {
+                level->getEnemiesInRadius(query, 60.0f, inRange);
+                found += inRange.size();
+            }
+        });
+
+        BenchResult result = summarize("level_enemies_in_radius_x64", enemyCount, samples);
+        result.note = "hits=" + std::to_string(found);
+        return result;
+    }
+
+    BenchResult benchEnemyConstruction(const BenchConfig& config, int enemyCount) {
+        CEnemyPool pool;
+        std::vector<std::unique_ptr<CEnemy>> enemies;
+        enemies.reserve(enemyCount);
+
+        std::vector<double> samples = measure(config, [&pool, &enemies, enemyCount]() {
+            enemies.clear();
+            for (int i = 0; i < enemyCount; i++) {
+                enemies.push_back(std::make_unique<CEnemy>(pool, EnemyType::ESQUELETO, i * 2.0f, 100.0f));
+            }
+        });
+        return summarize("enemy_construction", enemyCount, samples);
+    }
+
+    BenchResult benchSpawnRecycle(const BenchConfig& config, int enemyCount) {
+        CPhysics physics;
+        physics.setFixedTimestep(60.0f, 1);
+        CRandom::getGlobal().setSeed(BENCH_SEED);
+
+        auto level = createPopulatedLevel(&physics, 0);
+        const EnemyType types[] = {EnemyType::ZOMBIE, EnemyType::ESQUELETO, EnemyType::MURCIELAGO};
+        const sf::FloatRect everywhere(-1.0e6f, -1.0e6f, 2.0e6f, 2.0e6f);
+        std::vector<CEnemy*> spawned;
+
+        // Una oleada por iteración: N spawns que mueren y se retiran en el mismo frame
+        auto wave = [&level, &types, &everywhere, &spawned, enemyCount]() {
+            for (int i = 0; i < enemyCount; i++) {
+                level->addEnemy(types[i % 3], 50.0f + (i % 40) * 18.0f, 100.0f + (i / 40) * 12.0f);
+            }
+            level->getEnemiesInArea(everywhere, spawned);
+            for (CEnemy* enemy : spawned) {
+                enemy->setHealth(0);
+            }
+            level->removeDeadEnemies();
+        };
+
+        // Las reservas se cuentan a partir de la primera oleada (calentamiento). cpp_allocs
+        // solo ve el operator new; el allocator de Box2D se refleja en los cuerpos creados
+        wave();
+        uint64_t allocationsBefore = level->getSpawnStats().allocations;
+        size_t bodiesBefore = level->getSpawnStats().bodiesCreated;
+
+        std::vector<double> samples = measure(config, wave);
+
+        BenchResult result = summarize("spawn_recycle", enemyCount, samples);
+        result.note = "cpp_allocs=" + std::to_string(level->getSpawnStats().allocations - allocationsBefore) +
+                      " bodies=" + std::to_string(level->getSpawnStats().bodiesCreated - bodiesBefore) +
+                      " views=" + std::to_string(level->getSpawnStats().viewsCreated);
+        return result;
+    }
+
+    BenchResult benchLevelRender(const BenchConfig& config, int enemyCount) {
+        sf::RenderTexture target;
+        if (!target.create(800, 600)) {
+            return skippedResult("level_render", enemyCount, "sin contexto OpenGL");
+        }
+
+        CPhysics physics;
+        CRandom::getGlobal().setSeed(BENCH_SEED);
+        auto level = createPopulatedLevel(&physics, enemyCount);
+
+        std::vector<double> samples = measure(config, [&target, &level]() {
+            target.clear(sf::Color::Black);
+            level->render(target);
+            target.display();
+        });
+
+        const SpriteBatchStats& batchStats = level->getRenderStats();
+        BenchResult result = summarize("level_render", enemyCount, samples);
+        result.note = "draws=" + std::to_string(batchStats.drawCalls) + " verts=" + std::to_string(batchStats.vertices);
+        return result;
+    }
+
+    // INFORME
+    std::string toJson(const std::vector<BenchResult>& results, const BenchConfig& config) {
+        std::ostringstream json;
+        json << "{\n";
+        json << "  \"suite\": \"castelvania\",\n";
+        json << "  \"unit\": \"us\",\n";
+        json << "  \"iterations\": " << config.iterations << ",\n";
+        json << "  \"results\": [\n";
+
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& r = results[i];
+            json << "    {\"name\": \"" << r.name << "\", \"n\": " << r.count;
+            if (r.skipped) {
+                json << ", \"skipped\": true";
+            } else {
+                json << ", \"iterations\": " << r.iterations
+                     << ", \"mean\": " << r.meanUs
+                     << ", \"min\": " << r.minUs
+                     << ", \"median\": " << r.medianUs
+                     << ", \"p99\": " << r.p99Us;
+            }
+            if (!r.note.empty()) {
+                json << ", \"note\": \"" << r.note << "\"";
+            }
+            json << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+
+        json << "  ]\n";
+        json << "}\n";
+        return json.str();
+    }
+
+    void printResult(const BenchResult& r) {
+        std::cout << "  " << r.name << " [n=" << r.count << "] ";
+        if (r.skipped) {
+            std::cout << "omitido (" << r.note << ")" << std::endl;
+            return;
+        }
+        std::cout << "media " << r.meanUs << "us | mediana " << r.medianUs
+                  << "us | p99 " << r.p99Us << "us" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config{{10, 100, 1000}, 300, 30};
+    std::string outputPath = "bench_results.json";
+    bool texturesEnabled = true;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            config.sizes = {10, 100};
+            config.iterations = 50;
+            config.warmup = 5;
+        } else if (arg == "--out" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--no-textures") {
+            texturesEnabled = false;
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--quick] [--out archivo.json] [--no-textures]" << std::endl;
+            return -1;
+        }
+    }
+
+    CTextureCache::getInstance().setLoadingEnabled(texturesEnabled);
+
+    // Mismo atlas que el juego: enemigos y plataformas se agrupan por página en level_render
+    if (texturesEnabled) {
+        CEnemyPool::registerAtlasSheets();
+        CLevel::registerAtlasSheets();
+        CTextureAtlas::getInstance().build();
+    }
+
+    // Los constructores de CPhysics/CLevel escriben en consola: se silencia durante las mediciones
+    std::streambuf* consoleBuffer = std::cout.rdbuf();
+    std::ostringstream discarded;
+
+    std::vector<BenchResult> results;
+    for (int size : config.sizes) {
+        std::cout.rdbuf(discarded.rdbuf());
+
+        results.push_back(benchPhysicsUpdate(config, size));
+        results.push_back(benchUpdateEnemies(config, size));
+        results.push_back(benchClosestEnemy(config, size));
+        results.push_back(benchEnemiesInRadius(config, size));
+        results.push_back(benchEnemyConstruction(config, size));
+        results.push_back(benchSpawnRecycle(config, size));
+        results.push_back(benchLevelRender(config, size));
+
+        discarded.str("");
+        std::cout.rdbuf(consoleBuffer);
+    }
+
+    std::cout << "=== Castelvania bench ===" << std::endl;
+    for (const BenchResult& result : results) {
+        printResult(result);
+    }
+
+    std::ofstream output(outputPath);
+    if (!output.is_open()) {
+        std::cerr << "No se pudo escribir " << outputPath << std::endl;
+        return -1;
+    }
+    output << toJson(results, config);
+    std::cout << "Informe JSON: " << outputPath << std::endl;
+
+    return 0;
+}
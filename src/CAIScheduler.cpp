@@ -0,0 +1,64 @@
+#include "CAIScheduler.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    const float NS_TO_MS = 1.0e-6f;
+
+    // Los de los cubos activos dividen 256: con fases uint8 en turno rotatorio el reparto es exacto.
+    // CONGELADO no usa fases (CEnemyPool los recorre por tramos)
+    const uint32_t PERIODS[AI_BUCKET_COUNT] = {1, 2, 4, 30};
+    const char* const NAMES[AI_BUCKET_COUNT] = {"Cercano", "Medio", "Lejano", "Congelado"};
+}
+
+// Constructor
+CAIScheduler::CAIScheduler() : frame(0) {
+    resetStats();
+}
+
+// CUBOS
+uint32_t CAIScheduler::getPeriod(AIBucket bucket) {
+    return PERIODS[static_cast<int>(bucket)];
+}
+
+const char* CAIScheduler::getBucketName(AIBucket bucket) {
+    return NAMES[static_cast<int>(bucket)];
+}
+
+// ESTADISTICAS
+void CAIScheduler::record(AIBucket bucket, size_t enemies, size_t updates, uint64_t nanoseconds) {
+    AIBucketStats& bucketStats = stats[static_cast<int>(bucket)];
+    float ms = nanoseconds * NS_TO_MS;
+
+    bucketStats.enemies = enemies;
+    bucketStats.updates = updates;
+    bucketStats.lastMs = ms;
+    bucketStats.averageMs += (ms - bucketStats.averageMs) * STATS_SMOOTHING;
+    bucketStats.peakMs = std::max(bucketStats.peakMs, ms);
+}
+
+const AIBucketStats& CAIScheduler::getStats(AIBucket bucket) const {
+    return stats[static_cast<int>(bucket)];
+}
+
+void CAIScheduler::resetStats() {
+    stats.fill(AIBucketStats{0, 0, 0.0f, 0.0f, 0.0f});
+}
+
+void CAIScheduler::printStats() const {
+    // Formato en un stream local: std::cout conserva su precisión
+    std::ostringstream lines;
+    lines << std::fixed << std::setprecision(3);
+    lines << "--- IA por cubos (frame " << frame << ") ---\n";
+    for (int i = 0; i < AI_BUCKET_COUNT; i++) {
+        AIBucket bucket = static_cast<AIBucket>(i);
+        const AIBucketStats& bucketStats = stats[i];
+        lines << "  " << std::left << std::setw(10) << getBucketName(bucket) << std::right
+              << " cada " << getPeriod(bucket) << " frames: " << bucketStats.enemies << " enemigos, "
+              << bucketStats.updates << " ticks, " << bucketStats.averageMs << " ms (pico "
+              << bucketStats.peakMs << " ms)\n";
+    }
+    std::cout << lines.str() << std::flush;
+}
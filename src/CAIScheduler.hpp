@@ -0,0 +1,80 @@
+#ifndef CAISCHEDULER_HPP
+#define CAISCHEDULER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+// Cubos de actualización de IA, de más a menos frecuente
+enum class AIBucket {
+    CERCANO,     // Cerca del jugador: todos los frames
+    MEDIO,       // Al borde de la vista: uno de cada 2 frames
+    LEJANO,      // Activo pero fuera de la vista: uno de cada 4 frames
+    CONGELADO,   // Congelado por el LOD (ver CEnemyPool): uno de cada 30 frames
+    COUNT
+};
+
+const int AI_BUCKET_COUNT = static_cast<int>(AIBucket::COUNT);
+
+// Medidas de un cubo
+struct AIBucketStats {
+    size_t enemies;          // Enemigos asignados en el último frame
+    size_t updates;          // Ticks de IA que se ejecutaron en el último frame
+    float lastMs;
+    float averageMs;         // Media exponencial
+    float peakMs;            // Máximo desde el último resetStats()
+};
+
+// ===============================================
+// Planificador de IA por cubos
+// ===============================================
+// Cada enemigo cae en un cubo según su distancia al jugador y cada cubo tiene
+// su periodo en frames. Para que no haya picos, un enemigo no se actualiza en
+// el frame múltiplo del periodo sino en el que marca su fase (fija desde el
+// spawn y repartida en turno rotatorio): en cada frame le toca a una fracción
+// parecida de cada cubo. El planificador solo decide y mide; recorrer los
+// enemigos y acumular el tiempo de cada uno es cosa de CEnemyPool.
+class CAIScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr float NEAR_DISTANCE = 500.0f;     // Píxeles: hasta aquí, CERCANO (cubre la vista de 800x600)
+    static constexpr float MEDIUM_DISTANCE = 700.0f;   // Píxeles: hasta aquí, MEDIO; más lejos, LEJANO
+    static constexpr float STATS_SMOOTHING = 0.05f;    // Peso del último frame en la media
+
+private:
+    uint64_t frame;
+    std::array<AIBucketStats, AI_BUCKET_COUNT> stats;
+
+public:
+    CAIScheduler();
+
+    void beginFrame() { frame++; }
+    uint64_t getFrame() const { return frame; }
+
+    // Cubo de un enemigo activo (nunca CONGELADO: eso lo decide el LOD)
+    static AIBucket getBucket(float distanceSquared) {
+        if (distanceSquared <= NEAR_DISTANCE * NEAR_DISTANCE) return AIBucket::CERCANO;
+        if (distanceSquared <= MEDIUM_DISTANCE * MEDIUM_DISTANCE) return AIBucket::MEDIO;
+        return AIBucket::LEJANO;
+    }
+
+    static uint32_t getPeriod(AIBucket bucket);
+    static const char* getBucketName(AIBucket bucket);
+
+    // ¿Le toca a la fase phase en este frame?
+    bool isDue(AIBucket bucket, uint8_t phase) const {
+        return (frame + phase) % getPeriod(bucket) == 0;
+    }
+
+    // Estadísticas
+    void record(AIBucket bucket, size_t enemies, size_t updates, uint64_t nanoseconds);
+    static uint64_t elapsedNs(Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+    const AIBucketStats& getStats(AIBucket bucket) const;
+    void resetStats();
+    void printStats() const;
+};
+
+#endif // CAISCHEDULER_HPP
@@ -0,0 +1,49 @@
+#include "CAllocationCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> totalAllocations(0);
+    thread_local uint64_t threadAllocations = 0;
+}
+
+// CONSULTAS
+uint64_t CAllocationCounter::getThreadCount() {
+    return threadAllocations;
+}
+
+uint64_t CAllocationCounter::getTotalCount() {
+    return totalAllocations.load(std::memory_order_relaxed);
+}
+
+// OPERADORES GLOBALES
+void* operator new(std::size_t size) {
+    threadAllocations++;
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (size == 0) {
+        size = 1;
+    }
+
+    // Mismo contrato que el operator new estándar: reintentar mientras haya new_handler
+    while (true) {
+        if (void* memory = std::malloc(size)) {
+            return memory;
+        }
+
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
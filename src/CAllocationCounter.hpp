@@ -0,0 +1,25 @@
+#ifndef CALLOCATIONCOUNTER_HPP
+#define CALLOCATIONCOUNTER_HPP
+
+#include <cstdint>
+
+// ===============================================
+// Contador de reservas de memoria dinámica
+// ===============================================
+// CAllocationCounter.cpp sustituye el operator new global por uno que llama a
+// malloc y cuenta cada reserva, en total y por hilo. Sirve para comprobar que
+// un camino caliente (spawns, muertes) no toca el heap: se lee el contador del
+// hilo antes y después y se compara. El new[] y el new sin excepciones de la
+// biblioteca estándar pasan por este operator new, así que también cuentan.
+// Solo cuenta reservas de C++: Box2D reserva con b2Alloc (malloc) sus cuerpos,
+// fixtures, nodos del árbol del broadphase y contactos, y eso no pasa por aquí.
+// Contarlo exigiría compilar Box2D con un b2_user_settings.h propio; el lado de
+// Box2D de los spawns se sigue con los cuerpos creados en ellos
+// (EnemySpawnStats::bodiesCreated en CLevel).
+class CAllocationCounter {
+public:
+    static uint64_t getThreadCount();      // Reservas hechas por el hilo que llama
+    static uint64_t getTotalCount();       // Reservas de todos los hilos desde el arranque
+};
+
+#endif // CALLOCATIONCOUNTER_HPP
@@ -0,0 +1,71 @@
+#include "CCamera.hpp"
+#include <algorithm>
+
+// Constructor
+CCamera::CCamera(float width, float height)
+    : view(sf::FloatRect(0.0f, 0.0f, width, height)), bounds(0.0f, 0.0f, width, height),
+      followSpeed(DEFAULT_FOLLOW_SPEED) {
+}
+
+// CONFIGURACION
+void CCamera::setBounds(const sf::FloatRect& levelBounds) {
+    bounds = levelBounds;
+    view.setCenter(clampCenter(view.getCenter()));
+}
+
+void CCamera::setFollowSpeed(float speed) {
+    followSpeed = speed;
+}
+
+// SEGUIMIENTO
+void CCamera::follow(const sf::Vector2f& target, float deltaTime) {
+    sf::Vector2f goal = clampCenter(target);
+    if (followSpeed <= 0.0f) {
+        view.setCenter(goal);
+        return;
+    }
+    
+    // Acercarse una fracción del camino que no depende de los FPS
+    float blend = std::min(1.0f, followSpeed * deltaTime);
+    sf::Vector2f center = view.getCenter();
+    view.setCenter(center + (goal - center) * blend);
+}
+
+void CCamera::snapTo(const sf::Vector2f& target) {
+    view.setCenter(clampCenter(target));
+}
+
+// GETTERS
+const sf::View& CCamera::getView() const {
+    return view;
+}
+
+sf::FloatRect CCamera::getVisibleArea() const {
+    return getVisibleArea(view);
+}
+
+sf::FloatRect CCamera::getVisibleArea(const sf::View& view) {
+    const sf::Vector2f& center = view.getCenter();
+    const sf::Vector2f& size = view.getSize();
+    return sf::FloatRect(center.x - size.x / 2.0f, center.y - size.y / 2.0f, size.x, size.y);
+}
+
+// PRIVADOS
+sf::Vector2f CCamera::clampCenter(const sf::Vector2f& center) const {
+    sf::Vector2f half = view.getSize() / 2.0f;
+    sf::Vector2f clamped = center;
+    
+    if (bounds.width <= half.x * 2.0f) {
+        clamped.x = bounds.left + bounds.width / 2.0f;
+    } else {
+        clamped.x = std::min(std::max(center.x, bounds.left + half.x), bounds.left + bounds.width - half.x);
+    }
+    
+    if (bounds.height <= half.y * 2.0f) {
+        clamped.y = bounds.top + bounds.height / 2.0f;
+    } else {
+        clamped.y = std::min(std::max(center.y, bounds.top + half.y), bounds.top + bounds.height - half.y);
+    }
+    
+    return clamped;
+}
@@ -0,0 +1,45 @@
+#ifndef CCAMERA_HPP
+#define CCAMERA_HPP
+
+#include <SFML/Graphics.hpp>
+
+// ===============================================
+// Cámara del nivel
+// ===============================================
+// Un sf::View del tamaño de la ventana que sigue a un punto (el jugador) con
+// suavizado exponencial y sin salirse de los límites del nivel; si el nivel es
+// más pequeño que la vista en un eje, se centra en ese eje. Solo afecta al
+// dibujado: la simulación y las repeticiones no dependen de ella.
+class CCamera {
+private:
+    sf::View view;
+    sf::FloatRect bounds;
+    float followSpeed;           // 1/s: fracción del camino recorrida por segundo (<= 0: sin suavizado)
+
+public:
+    static constexpr float VIEW_WIDTH = 800.0f;
+    static constexpr float VIEW_HEIGHT = 600.0f;
+    static constexpr float DEFAULT_FOLLOW_SPEED = 8.0f;
+
+    CCamera(float width = VIEW_WIDTH, float height = VIEW_HEIGHT);
+
+    // Configuración
+    void setBounds(const sf::FloatRect& levelBounds);
+    void setFollowSpeed(float speed);
+
+    // Seguimiento
+    void follow(const sf::Vector2f& target, float deltaTime);
+    void snapTo(const sf::Vector2f& target);     // Sin suavizado (al cargar un nivel)
+
+    // Getters
+    const sf::View& getView() const;
+    sf::FloatRect getVisibleArea() const;
+
+    // Rectángulo del mundo que cubre una vista (sin rotación)
+    static sf::FloatRect getVisibleArea(const sf::View& view);
+
+private:
+    sf::Vector2f clampCenter(const sf::Vector2f& center) const;
+};
+
+#endif // CCAMERA_HPP
@@ -0,0 +1,155 @@
+#include "CChunkGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// Constructor
+CChunkGrid::CChunkGrid() : origin(0.0f, 0.0f), columns(0), rows(0), dormantCount(0) {
+}
+
+// CONSTRUCCION
+void CChunkGrid::reset(const sf::FloatRect& bounds) {
+    origin = sf::Vector2f(bounds.left, bounds.top);
+    columns = std::max(1, static_cast<int>(std::ceil(bounds.width / CHUNK_SIZE)));
+    rows = std::max(1, static_cast<int>(std::ceil(bounds.height / CHUNK_SIZE)));
+    
+    chunks.assign(static_cast<size_t>(columns) * rows, Chunk{{}, {}, {}, false});
+    loadedChunks.clear();
+    dormantCount = 0;
+}
+
+void CChunkGrid::addPlatform(uint32_t index, const sf::FloatRect& rect) {
+    addToChunks(&Chunk::platforms, index, rect);
+}
+
+void CChunkGrid::addSolid(uint32_t index, const sf::FloatRect& bounds) {
+    addToChunks(&Chunk::solids, index, bounds);
+}
+
+// CONSULTAS
+size_t CChunkGrid::getChunkCount() const {
+    return chunks.size();
+}
+
+int CChunkGrid::getChunkAt(const sf::Vector2f& position) const {
+    if (chunks.empty()) return NO_CHUNK;
+    
+    int column = static_cast<int>(std::floor((position.x - origin.x) / CHUNK_SIZE));
+    int row = static_cast<int>(std::floor((position.y - origin.y) / CHUNK_SIZE));
+    column = std::min(std::max(column, 0), columns - 1);
+    row = std::min(std::max(row, 0), rows - 1);
+    return row * columns + column;
+}
+
+int CChunkGrid::getChunk(int column, int row) const {
+    if (column < 0 || row < 0 || column >= columns || row >= rows) return NO_CHUNK;
+    return row * columns + column;
+}
+
+sf::Vector2i CChunkGrid::getCoords(int chunk) const {
+    return sf::Vector2i(chunk % columns, chunk / columns);
+}
+
+const std::vector<uint32_t>& CChunkGrid::getPlatforms(int chunk) const {
+    return chunks[chunk].platforms;
+}
+
+const std::vector<uint32_t>& CChunkGrid::getSolids(int chunk) const {
+    return chunks[chunk].solids;
+}
+
+// RESIDENCIA
+bool CChunkGrid::isLoaded(int chunk) const {
+    return chunk != NO_CHUNK && chunks[chunk].loaded;
+}
+
+void CChunkGrid::setLoaded(int chunk, bool loaded) {
+    if (chunk == NO_CHUNK || chunks[chunk].loaded == loaded) return;
+    
+    chunks[chunk].loaded = loaded;
+    if (loaded) {
+        loadedChunks.push_back(chunk);
+    } else {
+        loadedChunks.erase(std::find(loadedChunks.begin(), loadedChunks.end(), chunk));
+    }
+}
+
+size_t CChunkGrid::getLoadedCount() const {
+    return loadedChunks.size();
+}
+
+void CChunkGrid::getChunksToLoad(const sf::Vector2f& focus, std::vector<int>& out) const {
+    out.clear();
+    if (chunks.empty()) return;
+    
+    sf::Vector2i center = getCoords(getChunkAt(focus));
+    for (int row = center.y - LOAD_RADIUS; row <= center.y + LOAD_RADIUS; row++) {
+        for (int column = center.x - LOAD_RADIUS; column <= center.x + LOAD_RADIUS; column++) {
+            int chunk = getChunk(column, row);
+            if (chunk != NO_CHUNK && !chunks[chunk].loaded) {
+                out.push_back(chunk);
+            }
+        }
+    }
+}
+
+void CChunkGrid::getChunksToUnload(const sf::Vector2f& focus, std::vector<int>& out) const {
+    out.clear();
+    if (chunks.empty()) return;
+    
+    sf::Vector2i center = getCoords(getChunkAt(focus));
+    for (int chunk : loadedChunks) {
+        sf::Vector2i coords = getCoords(chunk);
+        if (std::max(std::abs(coords.x - center.x), std::abs(coords.y - center.y)) > KEEP_RADIUS) {
+            out.push_back(chunk);
+        }
+    }
+}
+
+int CChunkGrid::getPrefetchChunk(const sf::Vector2f& focus, const sf::Vector2f& direction) const {
+    if (chunks.empty() || (direction.x == 0.0f && direction.y == 0.0f)) return NO_CHUNK;
+    
+    // El primer chunk que cargaria si se sigue avanzando por el eje dominante
+    sf::Vector2i center = getCoords(getChunkAt(focus));
+    if (std::abs(direction.x) >= std::abs(direction.y)) {
+        return getChunk(center.x + (direction.x > 0.0f ? LOAD_RADIUS + 1 : -(LOAD_RADIUS + 1)), center.y);
+    }
+    return getChunk(center.x, center.y + (direction.y > 0.0f ? LOAD_RADIUS + 1 : -(LOAD_RADIUS + 1)));
+}
+
+// ENEMIGOS DORMIDOS
+void CChunkGrid::addDormantEnemy(int chunk, const DormantEnemy& enemy) {
+    chunks[chunk].dormantEnemies.push_back(enemy);
+    dormantCount++;
+}
+
+void CChunkGrid::takeDormantEnemies(int chunk, std::vector<DormantEnemy>& out) {
+    out.clear();
+    out.swap(chunks[chunk].dormantEnemies);
+    dormantCount -= out.size();
+}
+
+size_t CChunkGrid::getDormantCount() const {
+    return dormantCount;
+}
+
+void CChunkGrid::clearDormantEnemies() {
+    for (Chunk& chunk : chunks) {
+        chunk.dormantEnemies.clear();
+    }
+    dormantCount = 0;
+}
+
+// PRIVADOS
+void CChunkGrid::addToChunks(std::vector<uint32_t> Chunk::* list, uint32_t index, const sf::FloatRect& rect) {
+    if (chunks.empty()) return;
+    
+    // Un elemento largo (el suelo) aparece en todos los chunks que toca
+    sf::Vector2i first = getCoords(getChunkAt(sf::Vector2f(rect.left, rect.top)));
+    sf::Vector2i last = getCoords(getChunkAt(sf::Vector2f(rect.left + rect.width, rect.top + rect.height)));
+    for (int row = first.y; row <= last.y; row++) {
+        for (int column = first.x; column <= last.x; column++) {
+            (chunks[static_cast<size_t>(row) * columns + column].*list).push_back(index);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef CCHUNKGRID_HPP
+#define CCHUNKGRID_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// Enemigo de un chunk descargado: lo justo para volver a crearlo al recargarlo
+struct DormantEnemy {
+    uint32_t type;               // Índice de EnemyType
+    float x;
+    float y;
+    int32_t health;
+};
+
+// ===============================================
+// Rejilla de chunks del nivel (streaming)
+// ===============================================
+// Divide los límites del nivel en chunks cuadrados de CHUNK_SIZE y guarda, por
+// chunk, los índices de las plataformas y de los sólidos de colisión del layout
+// que lo tocan y los enemigos
+// dormidos (serializados al descargarlo). Solo lleva la contabilidad: qué chunks
+// hay que cargar o descargar alrededor de un foco y cuál precargar según la
+// dirección de avance. Crear y destruir cuerpos, plataformas y enemigos es cosa
+// de CLevel. Cargar usa LOAD_RADIUS y descargar KEEP_RADIUS, para que ir y venir
+// sobre un borde no cargue y descargue el mismo chunk en cada frame.
+class CChunkGrid {
+public:
+    static constexpr float CHUNK_SIZE = 1024.0f;
+    static const int LOAD_RADIUS = 1;            // Chunks (en cada eje) alrededor del foco que deben estar cargados
+    static const int KEEP_RADIUS = 2;            // Más allá de este radio se descargan
+    static const int NO_CHUNK = -1;
+
+private:
+    struct Chunk {
+        std::vector<uint32_t> platforms;         // Índices en LevelLayout::platforms
+        std::vector<uint32_t> solids;            // Índices en LevelLayout::solids
+        std::vector<DormantEnemy> dormantEnemies;
+        bool loaded;
+    };
+
+    std::vector<Chunk> chunks;                   // columns * rows, por filas
+    std::vector<int> loadedChunks;               // Solo los cargados: descargar no recorre todo el mapa
+    sf::Vector2f origin;
+    int columns;
+    int rows;
+    size_t dormantCount;
+
+public:
+    CChunkGrid();
+
+    // Construcción
+    void reset(const sf::FloatRect& bounds);     // Vacía la rejilla (también los enemigos dormidos)
+    void addPlatform(uint32_t index, const sf::FloatRect& rect);
+    void addSolid(uint32_t index, const sf::FloatRect& bounds);
+
+    // Consultas
+    size_t getChunkCount() const;
+    int getChunkAt(const sf::Vector2f& position) const;   // Fuera de los límites: el chunk del borde
+    int getChunk(int column, int row) const;              // NO_CHUNK si está fuera de la rejilla
+    sf::Vector2i getCoords(int chunk) const;
+    const std::vector<uint32_t>& getPlatforms(int chunk) const;
+    const std::vector<uint32_t>& getSolids(int chunk) const;
+
+    // Residencia
+    bool isLoaded(int chunk) const;
+    void setLoaded(int chunk, bool loaded);
+    size_t getLoadedCount() const;
+    void getChunksToLoad(const sf::Vector2f& focus, std::vector<int>& out) const;
+    void getChunksToUnload(const sf::Vector2f& focus, std::vector<int>& out) const;
+    int getPrefetchChunk(const sf::Vector2f& focus, const sf::Vector2f& direction) const;  // NO_CHUNK si no hay
+
+    // Enemigos dormidos
+    void addDormantEnemy(int chunk, const DormantEnemy& enemy);
+    void takeDormantEnemies(int chunk, std::vector<DormantEnemy>& out);
+    size_t getDormantCount() const;
+    void clearDormantEnemies();
+
+private:
+    void addToChunks(std::vector<uint32_t> Chunk::* list, uint32_t index, const sf::FloatRect& rect);
+};
+
+#endif // CCHUNKGRID_HPP
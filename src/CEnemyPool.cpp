@@ -0,0 +1,971 @@
+#include "CEnemyPool.hpp"
+#include "CRandom.hpp"
+#include "CTraceWriter.hpp"
+#include "CJobSystem.hpp"
+#include <iostream>
+#include <cmath>
+#include <utility>
+
+namespace {
+    const uint32_t INVALID_SLOT = EnemyId::INVALID_INDEX;
+
+    float distanceBetween(const sf::Vector2f& a, const sf::Vector2f& b) {
+        float dx = b.x - a.x;
+        float dy = b.y - a.y;
+        return std::sqrt(dx * dx + dy * dy);
+    }
+}
+
+// Constructor
+CEnemyPool::CEnemyPool()
+    : freeHead(INVALID_SLOT), activeCount(0), frozenCursor(0), aiClock(0.0), nextPhase(0), physics(nullptr),
+      bodiesCreated(0), bodiesRecycled(0) {
+    fallbackShape.setSize(sf::Vector2f(FALLBACK_SIZE, FALLBACK_SIZE));
+}
+
+// TABLA DE TIPOS
+const EnemyTypeInfo& CEnemyPool::getTypeInfo(EnemyType type) {
+    // Indexada por EnemyType (mismo orden que el enum)
+    static const EnemyTypeInfo table[ENEMY_TYPE_COUNT] = {
+        // MURCIELAGO - murcielago.png: 1 fila de 5 frames (siempre en movimiento)
+        {"Murcielago", "assets/murcielago.png", 30, 10, 120.0f, 200.0f, 35.0f, 1.0f, sf::Color::Magenta,
+         0.15f, {0, 0, 5, 106, 127}, {0, 0, 5, 106, 127}, sf::Vector2f(1.0f, 1.0f),
+         true, 0.0f, 12.0f, 10.0f, 6.0f},
+        // ESQUELETO - skeleton.png: fila 1 IDLE (1 frame), fila 2 MOVING (5 frames)
+        {"Esqueleto", "assets/skeleton.png", 60, 20, 80.0f, 160.0f, 40.0f, 1.5f, sf::Color::White,
+         0.2f, {40, 0, 1, 550, 186}, {40, 186, 5, 130, 186}, sf::Vector2f(0.7f, 0.7f),
+         false, 9.0f, 0.0f, 10.0f, 5.0f},
+        // ZOMBIE - zombie.png: fila 1 IDLE (1 frame), fila 2 MOVING (4 frames)
+        {"Zombie", "assets/zombie.png", 100, 30, 50.0f, 140.0f, 45.0f, 2.0f, sf::Color::Green,
+         0.3f, {45, 0, 1, 177, 158}, {0, 158, 4, 174, 158}, sf::Vector2f(0.9f, 0.9f),
+         false, 0.18f, 0.0f, 8.0f, 3.0f}
+    };
+
+    return table[static_cast<int>(type)];
+}
+
+void CEnemyPool::warmUpTextures() {
+    CTextureCache& cache = CTextureCache::getInstance();
+    const CTextureAtlas& atlas = CTextureAtlas::getInstance();
+    for (int i = 0; i < ENEMY_TYPE_COUNT; i++) {
+        EnemyType type = static_cast<EnemyType>(i);
+        // Los tipos empaquetados en el atlas ya no necesitan su hoja suelta
+        if (atlas.hasStrip(getStripName(type, EnemyState::IDLE)) &&
+            atlas.hasStrip(getStripName(type, EnemyState::MOVING))) {
+            continue;
+        }
+        cache.acquire(getTypeInfo(type).texturePath);
+    }
+}
+
+std::string CEnemyPool::getStripName(EnemyType type, EnemyState state) {
+    return getTypeInfo(type).name + (state == EnemyState::IDLE ? ".idle" : ".moving");
+}
+
+void CEnemyPool::registerAtlasSheets() {
+    CTextureAtlas& atlas = CTextureAtlas::getInstance();
+    for (int i = 0; i < ENEMY_TYPE_COUNT; i++) {
+        EnemyType type = static_cast<EnemyType>(i);
+        const EnemyTypeInfo& info = getTypeInfo(type);
+        const EnemySheetStrip& idle = info.idleStrip;
+        const EnemySheetStrip& move = info.movingStrip;
+
+        atlas.addSheet(info.texturePath, {
+            {getStripName(type, EnemyState::IDLE), idle.startX, idle.startY, idle.frameCount, idle.frameWidth, idle.frameHeight},
+            {getStripName(type, EnemyState::MOVING), move.startX, move.startY, move.frameCount, move.frameWidth, move.frameHeight}
+        });
+    }
+}
+
+// GESTION
+EnemyId CEnemyPool::spawn(EnemyType type, float x, float y, CEnemy* owner) {
+    const EnemyTypeInfo& info = getTypeInfo(type);
+    uint32_t dense = static_cast<uint32_t>(types.size());
+
+    // Reservar slot (reutilizando uno libre si lo hay)
+    uint32_t slot;
+    if (freeHead != INVALID_SLOT) {
+        slot = freeHead;
+        freeHead = slotDense[slot];
+    } else {
+        slot = static_cast<uint32_t>(slotDense.size());
+        slotDense.push_back(0);
+        slotGeneration.push_back(0);
+    }
+    slotGeneration[slot]++;
+    slotDense[slot] = dense;
+    denseSlot.push_back(slot);
+
+    // Tablas de frames compartidas por tipo: solo el primer spawn de cada tipo las resuelve
+    const std::vector<AtlasFrame>& idleFrames = frameTables[static_cast<int>(type)][static_cast<int>(EnemyState::IDLE)];
+    if (idleFrames.empty()) {
+        resolveFrameTables(type);
+    }
+    bool hasFrames = !idleFrames.empty();
+
+    types.push_back(type);
+    positions.emplace_back(x, y);
+    velocities.emplace_back(0.0f, 0.0f);
+    health.push_back(info.maxHealth);
+    cooldowns.push_back(0.0f);
+    directionTimers.push_back(0.0f);
+    movementDirections.push_back(1);
+    grounded.push_back(0);
+    moving.push_back(0);
+    states.push_back(EnemyState::IDLE);
+    frames.push_back(0);
+    animationTimers.push_back(0.0f);
+    aiTicks.push_back(aiClock);
+    aiPhases.push_back(nextPhase++);
+    sustainedCommands.push_back(AICommand{dense, 0.0f, AIAction::NONE, 0, 0, 0, 0.0f});
+
+    owners.push_back(owner);
+    bodyHandles.emplace_back();
+    bodies.push_back(nullptr);
+    sprites.emplace_back();
+    textured.push_back(hasFrames ? 1 : 0);
+    fillColors.push_back(info.color);
+
+    if (hasFrames) {
+        sprites.back().setScale(info.spriteScale);
+        updateSpriteFrame(dense);
+    }
+
+    // Nace activo; si está lejos lo congelará el siguiente freezeDistant()
+    swapEntries(dense, activeCount);
+    activeCount++;
+
+    return EnemyId(slot, slotGeneration[slot]);
+}
+
+void CEnemyPool::release(EnemyId id) {
+    if (!contains(id)) {
+        return;
+    }
+
+    uint32_t removed = slotDense[id.index];
+    uint32_t last = static_cast<uint32_t>(types.size()) - 1;
+
+    releasePhysics(removed);
+
+    // Si era activo, primero pasa al final del tramo de activos para no romper la partición
+    if (removed < activeCount) {
+        activeCount--;
+        swapEntries(removed, activeCount);
+        removed = static_cast<uint32_t>(activeCount);
+    }
+
+    // Swap-and-pop en todas las columnas
+    if (removed != last) {
+        swapEntries(removed, last);
+    }
+
+    types.pop_back();
+    positions.pop_back();
+    velocities.pop_back();
+    health.pop_back();
+    cooldowns.pop_back();
+    directionTimers.pop_back();
+    movementDirections.pop_back();
+    grounded.pop_back();
+    moving.pop_back();
+    states.pop_back();
+    frames.pop_back();
+    animationTimers.pop_back();
+    aiTicks.pop_back();
+    aiPhases.pop_back();
+    sustainedCommands.pop_back();
+    owners.pop_back();
+    bodyHandles.pop_back();
+    bodies.pop_back();
+    sprites.pop_back();
+    textured.pop_back();
+    fillColors.pop_back();
+    denseSlot.pop_back();
+
+    // Invalidar el id y encadenar el slot en la lista libre
+    slotGeneration[id.index]++;
+    slotDense[id.index] = freeHead;
+    freeHead = id.index;
+}
+
+bool CEnemyPool::contains(EnemyId id) const {
+    return id.index < slotGeneration.size() &&
+           slotGeneration[id.index] == id.generation &&
+           (id.generation & 1u) != 0;
+}
+
+size_t CEnemyPool::indexOf(EnemyId id) const {
+    return slotDense[id.index];
+}
+
+size_t CEnemyPool::size() const {
+    return types.size();
+}
+
+void CEnemyPool::reserve(size_t capacity) {
+    slotDense.reserve(capacity);
+    slotGeneration.reserve(capacity);
+    denseSlot.reserve(capacity);
+    types.reserve(capacity);
+    positions.reserve(capacity);
+    velocities.reserve(capacity);
+    health.reserve(capacity);
+    cooldowns.reserve(capacity);
+    directionTimers.reserve(capacity);
+    movementDirections.reserve(capacity);
+    grounded.reserve(capacity);
+    moving.reserve(capacity);
+    states.reserve(capacity);
+    frames.reserve(capacity);
+    animationTimers.reserve(capacity);
+    aiTicks.reserve(capacity);
+    aiPhases.reserve(capacity);
+    sustainedCommands.reserve(capacity);
+    owners.reserve(capacity);
+    bodyHandles.reserve(capacity);
+    bodies.reserve(capacity);
+    sprites.reserve(capacity);
+    textured.reserve(capacity);
+    fillColors.reserve(capacity);
+}
+
+// FISICAS
+void CEnemyPool::setPhysics(CPhysics* physics) {
+    // Los cuerpos de reserva pertenecen al mundo anterior
+    if (physics != this->physics) {
+        destroySpareBodies();
+    }
+    this->physics = physics;
+}
+
+bool CEnemyPool::attachPhysics(size_t index) {
+    if (!physics) {
+        std::cerr << "Error: Sistema de fisicas nulo para enemigo" << std::endl;
+        return false;
+    }
+
+    releasePhysics(index);
+
+    // Reutilizar un cuerpo aparcado del mismo tipo antes de crear otro
+    std::vector<BodyHandle>& spares = spareBodies[static_cast<int>(types[index])];
+    while (!spares.empty() && !bodyHandles[index].isValid()) {
+        BodyHandle spare = spares.back();
+        spares.pop_back();
+        if (physics->recycleEnemyBody(spare, positions[index].x, positions[index].y, owners[index])) {
+            bodyHandles[index] = spare;
+            bodiesRecycled++;
+        }
+    }
+    if (!bodyHandles[index].isValid()) {
+        bodyHandles[index] = physics->createEnemyBody(positions[index].x, positions[index].y, owners[index]);
+        bodiesCreated++;
+    }
+    bodies[index] = physics->getBody(bodyHandles[index]);
+
+    if (!bodies[index]) {
+        std::cerr << "Error: No se pudo crear el cuerpo fisico del enemigo" << std::endl;
+        bodyHandles[index] = BodyHandle();
+        return false;
+    }
+
+    updatePhysicsPosition(index);
+
+    // Un congelado conserva el cuerpo fuera de la simulación hasta que despierte
+    if (index >= activeCount) {
+        bodies[index]->SetEnabled(false);
+    }
+    return true;
+}
+
+void CEnemyPool::releasePhysics(size_t index) {
+    if (physics && bodies[index]) {
+        // Aparcado: deshabilitado (fuera del broadphase) hasta que otro enemigo de su tipo lo pida
+        bodies[index]->SetEnabled(false);
+        spareBodies[static_cast<int>(types[index])].push_back(bodyHandles[index]);
+    }
+
+    bodyHandles[index] = BodyHandle();
+    bodies[index] = nullptr;
+    velocities[index].SetZero();
+}
+
+void CEnemyPool::preallocateBodies(EnemyType type, size_t count) {
+    if (!physics) return;
+
+    std::vector<BodyHandle>& spares = spareBodies[static_cast<int>(type)];
+    spares.reserve(count);
+    while (spares.size() < count) {
+        BodyHandle handle = physics->createEnemyBody(0.0f, 0.0f, nullptr);
+        b2Body* body = physics->getBody(handle);
+        if (!body) return;
+
+        body->SetEnabled(false);
+        spares.push_back(handle);
+        bodiesCreated++;
+    }
+}
+
+void CEnemyPool::destroySpareBodies() {
+    for (std::vector<BodyHandle>& spares : spareBodies) {
+        if (physics) {
+            for (BodyHandle handle : spares) {
+                physics->destroyBody(handle);
+            }
+        }
+        spares.clear();
+    }
+}
+
+size_t CEnemyPool::getSpareBodyCount() const {
+    size_t count = 0;
+    for (const std::vector<BodyHandle>& spares : spareBodies) {
+        count += spares.size();
+    }
+    return count;
+}
+
+// BUCLES POR LOTES
+void CEnemyPool::updateAI(const sf::Vector2f& playerPosition, float deltaTime) {
+    TRACE_SCOPE("CEnemyPool::updateAI");
+
+    aiClock += deltaTime;
+    aiScheduler.beginFrame();
+
+    // Repartir los activos por distancia (el orden dentro de cada cubo es el del pool)
+    for (std::vector<size_t>& indices : bucketIndices) {
+        indices.clear();
+    }
+    for (size_t i = 0; i < activeCount; i++) {
+        if (health[i] <= 0) continue;
+
+        float dx = positions[i].x - playerPosition.x;
+        float dy = positions[i].y - playerPosition.y;
+        bucketIndices[static_cast<int>(CAIScheduler::getBucket(dx * dx + dy * dy))].push_back(i);
+    }
+
+    updateBucket(AIBucket::CERCANO, playerPosition);
+    updateBucket(AIBucket::MEDIO, playerPosition);
+    updateBucket(AIBucket::LEJANO, playerPosition);
+    updateFrozen();
+}
+
+void CEnemyPool::update(float deltaTime) {
+    for (size_t i = 0; i < activeCount; i++) {
+        if (health[i] > 0) {
+            updateAt(i, deltaTime);
+        }
+    }
+}
+
+void CEnemyPool::syncFromPhysics() {
+    if (!physics) return;
+
+    for (size_t i = 0; i < activeCount; i++) {
+        if (bodies[i] && health[i] > 0) {
+            syncFromPhysicsAt(i);
+        }
+    }
+}
+
+void CEnemyPool::render(CSpriteBatch& batch) {
+    for (size_t i = 0; i < types.size(); i++) {
+        if (health[i] <= 0) continue;
+        renderAt(i, batch);
+    }
+}
+
+void CEnemyPool::render(CSpriteBatch& batch, const std::vector<size_t>& indices) {
+    for (size_t i : indices) {
+        if (i >= types.size() || health[i] <= 0) continue;
+        renderAt(i, batch);
+    }
+}
+
+// LOD
+void CEnemyPool::wake(size_t i) {
+    if (i < activeCount || i >= types.size()) return;
+
+    // Ponerse al día con el tiempo que pasó desde su último tick
+    updateFrozenAt(i, static_cast<float>(aiClock - aiTicks[i]));
+
+    if (bodies[i]) {
+        bodies[i]->SetEnabled(true);
+        bodies[i]->SetAwake(true);
+        physics->resetInterpolation(bodyHandles[i]);
+    }
+
+    swapEntries(i, activeCount);
+    activeCount++;
+}
+
+void CEnemyPool::freezeDistant(const sf::Vector2f& playerPosition) {
+    // De atrás adelante: el que se congela se cambia por el último activo, ya revisado
+    float freezeDistanceSquared = FREEZE_DISTANCE * FREEZE_DISTANCE;
+    for (size_t i = activeCount; i-- > 0;) {
+        float dx = positions[i].x - playerPosition.x;
+        float dy = positions[i].y - playerPosition.y;
+        if (health[i] > 0 && dx * dx + dy * dy > freezeDistanceSquared) {
+            freezeAt(i);
+        }
+    }
+}
+
+void CEnemyPool::freezeAt(size_t i) {
+    if (bodies[i]) {
+        // Deshabilitado: Box2D lo saca del broadphase y destruye sus contactos
+        bodies[i]->SetEnabled(false);
+    }
+    setMoving(i, false);
+    sustainedCommands[i].action = AIAction::NONE;   // Al despertar no arrastra una fuerza antigua
+
+    activeCount--;
+    swapEntries(i, activeCount);
+}
+
+void CEnemyPool::updateBucket(AIBucket bucket, const sf::Vector2f& playerPosition) {
+    CAIScheduler::Clock::time_point start = CAIScheduler::Clock::now();
+
+    // Los que tocan este frame, con el tiempo desde su último tick (el patrullaje y
+    // el fallback sin físicas no pierden tiempo). CPhysics borra las fuerzas en cada
+    // frame: los que no tocan reaplican la de su última decisión, así que solo se
+    // escalona la decisión y no el empuje (la velocidad no depende del cubo)
+    const std::vector<size_t>& indices = bucketIndices[static_cast<int>(bucket)];
+    aiCommands.clear();
+    for (size_t i : indices) {
+        if (!aiScheduler.isDue(bucket, aiPhases[i])) {
+            sustainCommand(i);
+            continue;
+        }
+
+        aiCommands.push_back(AICommand{static_cast<uint32_t>(i), static_cast<float>(aiClock - aiTicks[i]),
+                                       AIAction::NONE, 0, 0, 0, 0.0f});
+        aiTicks[i] = aiClock;
+    }
+
+    // Decidir (en paralelo si son muchos) y aplicar en este hilo, en el orden del pool
+    decideCommands(playerPosition);
+    for (const AICommand& command : aiCommands) {
+        applyCommand(command, playerPosition);
+    }
+
+    aiScheduler.record(bucket, indices.size(), aiCommands.size(), CAIScheduler::elapsedNs(start));
+}
+
+void CEnemyPool::sustainCommand(size_t i) {
+    const AICommand& command = sustainedCommands[i];
+    switch (command.action) {
+        case AIAction::CHASE:
+            // Sin el salto: es un impulso y solo se intenta al decidir
+            applyMovementForce(i, static_cast<float>(command.directionX) * command.thrust);
+            break;
+        case AIAction::FLY:
+            flyTowards(i, command.directionX, command.directionY);
+            break;
+        case AIAction::PATROL:
+            patrol(i);
+            break;
+        default:
+            // NONE, IDLE y ATTACK no empujan; MOVE_TOWARDS (sin físicas) ya usa elapsed
+            break;
+    }
+}
+
+void CEnemyPool::decideCommands(const sf::Vector2f& playerPosition) {
+    auto decideRange = [this, &playerPosition](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; k++) {
+            aiCommands[k] = decideAt(aiCommands[k].index, playerPosition, aiCommands[k].elapsed);
+        }
+    };
+
+    if (aiCommands.size() < PARALLEL_AI_THRESHOLD) {
+        decideRange(0, aiCommands.size());
+        return;
+    }
+
+    TRACE_SCOPE("CEnemyPool::decideCommands");
+    CJobSystem::getInstance().parallelFor(aiCommands.size(), AI_BATCH_SIZE, decideRange);
+}
+
+void CEnemyPool::updateFrozen() {
+    CAIScheduler::Clock::time_point start = CAIScheduler::Clock::now();
+
+    size_t frozenCount = types.size() - activeCount;
+    size_t updates = 0;
+    if (frozenCount > 0) {
+        // Una fracción por frame: cada congelado recibe tick una vez por periodo del cubo
+        size_t period = CAIScheduler::getPeriod(AIBucket::CONGELADO);
+        size_t slice = (frozenCount + period - 1) / period;
+        for (; updates < slice; updates++) {
+            if (frozenCursor < activeCount || frozenCursor >= types.size()) {
+                frozenCursor = activeCount;
+            }
+            size_t i = frozenCursor++;
+            updateFrozenAt(i, static_cast<float>(aiClock - aiTicks[i]));
+        }
+    }
+
+    aiScheduler.record(AIBucket::CONGELADO, frozenCount, updates, CAIScheduler::elapsedNs(start));
+}
+
+void CEnemyPool::updateFrozenAt(size_t i, float elapsed) {
+    aiTicks[i] = aiClock;
+    if (health[i] <= 0 || elapsed <= 0.0f) return;
+
+    if (cooldowns[i] > 0.0f) {
+        cooldowns[i] -= elapsed;
+    }
+
+    // Solo la decisión de patrullaje; las fuerzas esperan a que despierte
+    directionTimers[i] += elapsed;
+    if (directionTimers[i] >= DIRECTION_CHANGE_TIME) {
+        movementDirections[i] = static_cast<int8_t>(CRandom::getGlobal().nextInt(-1, 1));
+        directionTimers[i] = 0.0f;
+    }
+}
+
+void CEnemyPool::swapEntries(size_t a, size_t b) {
+    if (a == b) return;
+
+    std::swap(types[a], types[b]);
+    std::swap(positions[a], positions[b]);
+    std::swap(velocities[a], velocities[b]);
+    std::swap(health[a], health[b]);
+    std::swap(cooldowns[a], cooldowns[b]);
+    std::swap(directionTimers[a], directionTimers[b]);
+    std::swap(movementDirections[a], movementDirections[b]);
+    std::swap(grounded[a], grounded[b]);
+    std::swap(moving[a], moving[b]);
+    std::swap(states[a], states[b]);
+    std::swap(frames[a], frames[b]);
+    std::swap(animationTimers[a], animationTimers[b]);
+    std::swap(aiTicks[a], aiTicks[b]);
+    std::swap(aiPhases[a], aiPhases[b]);
+    std::swap(sustainedCommands[a], sustainedCommands[b]);
+    std::swap(owners[a], owners[b]);
+    std::swap(bodyHandles[a], bodyHandles[b]);
+    std::swap(bodies[a], bodies[b]);
+    std::swap(sprites[a], sprites[b]);
+    std::swap(textured[a], textured[b]);
+    std::swap(fillColors[a], fillColors[b]);
+
+    std::swap(denseSlot[a], denseSlot[b]);
+    slotDense[denseSlot[a]] = static_cast<uint32_t>(a);
+    slotDense[denseSlot[b]] = static_cast<uint32_t>(b);
+}
+
+// OPERACIONES POR ENEMIGO
+void CEnemyPool::updateAIAt(size_t i, const sf::Vector2f& playerPosition, float deltaTime) {
+    applyCommand(decideAt(i, playerPosition, deltaTime), playerPosition);
+}
+
+AICommand CEnemyPool::decideAt(size_t i, const sf::Vector2f& playerPosition, float elapsed) const {
+    AICommand command{static_cast<uint32_t>(i), elapsed, AIAction::NONE, 0, 0, 0, 0.0f};
+    if (health[i] <= 0) return command;
+
+    const EnemyTypeInfo& info = getTypeInfo(types[i]);
+    sf::Vector2f direction = playerPosition - positions[i];
+    float distanceToPlayer = distanceBetween(positions[i], playerPosition);
+
+    // Patrullaje cuando no detecta al jugador
+    if (distanceToPlayer > info.detectionRange * 1.2f) {
+        command.action = bodies[i] ? AIAction::PATROL : AIAction::IDLE;
+        return command;
+    }
+
+    // Logica de IA mas agresiva
+    if (distanceToPlayer <= info.attackRange && cooldowns[i] <= 0.0f) {
+        command.action = AIAction::ATTACK;
+        return command;
+    }
+    if (!bodies[i]) {
+        // Fallback sin fisicas
+        command.action = AIAction::MOVE_TOWARDS;
+        return command;
+    }
+
+    // Ya encima del jugador (esperando el cooldown): el murcielago sigue a lo suyo, el resto se para
+    if (distanceToPlayer <= info.attackRange) {
+        command.action = types[i] == EnemyType::MURCIELAGO ? AIAction::NONE : AIAction::IDLE;
+        return command;
+    }
+
+    command.directionX = static_cast<int8_t>(direction.x > 0 ? 1 : -1);
+    switch (types[i]) {
+        case EnemyType::MURCIELAGO:
+            command.action = AIAction::FLY;
+            command.directionY = static_cast<int8_t>(direction.y > 0 ? 1 : -1);
+            break;
+        case EnemyType::ESQUELETO:
+            // Salto mas frecuente
+            command.action = AIAction::CHASE;
+            command.thrust = 1.3f;
+            command.jump = (direction.y < -20.0f || std::abs(direction.x) < 30.0f) ? 1 : 0;
+            break;
+        case EnemyType::ZOMBIE:
+            command.action = AIAction::CHASE;
+            command.thrust = 1.0f;
+            break;
+    }
+    return command;
+}
+
+void CEnemyPool::applyCommand(const AICommand& command, const sf::Vector2f& playerPosition) {
+    size_t i = command.index;
+    if (health[i] <= 0) return;
+
+    // Cambio de dirección de patrullaje: aquí y no al decidir, para consumir el RNG global en orden
+    directionTimers[i] += command.elapsed;
+    if (directionTimers[i] >= DIRECTION_CHANGE_TIME) {
+        movementDirections[i] = static_cast<int8_t>(CRandom::getGlobal().nextInt(-1, 1));
+        directionTimers[i] = 0.0f;
+    }
+
+    sustainedCommands[i] = command;
+
+    switch (command.action) {
+        case AIAction::NONE:
+            break;
+        case AIAction::IDLE:
+            setMoving(i, false);
+            break;
+        case AIAction::ATTACK:
+            attack(i);
+            setMoving(i, false);
+            break;
+        case AIAction::CHASE:
+            applyMovementForce(i, static_cast<float>(command.directionX) * command.thrust);
+            setMoving(i, true);
+            if (command.jump) {
+                jump(i);
+            }
+            break;
+        case AIAction::FLY:
+            flyTowards(i, command.directionX, command.directionY);
+            break;
+        case AIAction::PATROL:
+            patrol(i);
+            break;
+        case AIAction::MOVE_TOWARDS:
+            moveTowards(i, playerPosition, command.elapsed);
+            break;
+    }
+}
+
+void CEnemyPool::updateAt(size_t i, float deltaTime) {
+    if (cooldowns[i] > 0.0f) {
+        cooldowns[i] -= deltaTime;
+    }
+
+    // En el suelo si apenas se mueve en vertical
+    if (bodies[i]) {
+        grounded[i] = std::abs(velocities[i].y) < 0.5f;
+    }
+
+    if (textured[i]) {
+        updateAnimationAt(i, deltaTime);
+    }
+
+    // Fin del parpadeo de daño
+    if (health[i] > 0 && fillColors[i] == sf::Color::Red) {
+        fillColors[i] = getTypeInfo(types[i]).color;
+    }
+}
+
+void CEnemyPool::updateAnimationAt(size_t i, float deltaTime) {
+    animationTimers[i] += deltaTime;
+
+    if (animationTimers[i] >= getTypeInfo(types[i]).animationSpeed) {
+        animationTimers[i] = 0.0f;
+
+        int frameCount = static_cast<int>(getCurrentFrames(i).size());
+        frames[i] = static_cast<uint8_t>(frameCount > 1 ? (frames[i] + 1) % frameCount : 0);
+
+        // Solo se toca el sprite cuando cambia el frame
+        updateSpriteFrame(i);
+    }
+}
+
+void CEnemyPool::syncFromPhysicsAt(size_t i) {
+    // Posicion interpolada entre los dos ultimos pasos fijos de la simulacion
+    positions[i] = physics->getInterpolatedPosition(bodyHandles[i]);
+    velocities[i] = bodies[i]->GetLinearVelocity();
+    grounded[i] = std::abs(velocities[i].y) < 0.5f;
+}
+
+void CEnemyPool::renderAt(size_t i, sf::RenderTarget& target) {
+    if (textured[i]) {
+        // La posición del sprite solo se escribe al dibujar
+        sprites[i].setPosition(positions[i]);
+        target.draw(sprites[i]);
+    } else {
+        fallbackShape.setPosition(positions[i]);
+        fallbackShape.setFillColor(fillColors[i]);
+        target.draw(fallbackShape);
+    }
+}
+
+void CEnemyPool::renderAt(size_t i, CSpriteBatch& batch) {
+    if (textured[i]) {
+        sprites[i].setPosition(positions[i]);
+        batch.draw(sprites[i]);
+    } else {
+        batch.drawRect(sf::FloatRect(positions[i].x, positions[i].y, FALLBACK_SIZE, FALLBACK_SIZE), fillColors[i]);
+    }
+}
+
+sf::FloatRect CEnemyPool::getBoundsAt(size_t i) const {
+    if (textured[i]) {
+        const sf::IntRect& rect = getCurrentFrames(i)[frames[i]].rect;
+        const sf::Vector2f& scale = getTypeInfo(types[i]).spriteScale;
+        return sf::FloatRect(positions[i].x, positions[i].y,
+                             rect.width * scale.x, rect.height * scale.y);
+    }
+    return sf::FloatRect(positions[i].x, positions[i].y, FALLBACK_SIZE, FALLBACK_SIZE);
+}
+
+// IA
+void CEnemyPool::moveTowards(size_t i, const sf::Vector2f& targetPosition, float deltaTime) {
+    if (health[i] <= 0) return;
+
+    // Si tiene fisicas habilitadas, usar movimiento con fisicas
+    if (bodies[i]) {
+        moveWithPhysics(i, targetPosition);
+        return;
+    }
+
+    const EnemyTypeInfo& info = getTypeInfo(types[i]);
+    sf::Vector2f direction = targetPosition - positions[i];
+    float distance = distanceBetween(positions[i], targetPosition);
+
+    if (distance <= info.attackRange) {
+        setMoving(i, false);
+        return;
+    }
+
+    if (distance > 0) {
+        direction.x /= distance;
+        direction.y /= distance;
+        positions[i] += direction * info.speed * deltaTime;
+        setMoving(i, true);
+    }
+}
+
+void CEnemyPool::moveWithPhysics(size_t i, const sf::Vector2f& targetPosition) {
+    if (!bodies[i] || health[i] <= 0) return;
+
+    const EnemyTypeInfo& info = getTypeInfo(types[i]);
+    float distance = distanceBetween(positions[i], targetPosition);
+
+    if (distance <= info.attackRange) {
+        setMoving(i, false);
+        return;
+    }
+
+    sf::Vector2f direction = targetPosition - positions[i];
+    float moveDirection = 0.0f;
+
+    // Deteccion de movimiento mas sensible
+    if (std::abs(direction.x) > 5.0f) {
+        moveDirection = (direction.x > 0) ? 1.0f : -1.0f;
+        setMoving(i, true);
+    } else {
+        setMoving(i, false);
+    }
+
+    // Aplicar movimiento segun el tipo
+    if (info.flyCapable && types[i] == EnemyType::MURCIELAGO) {
+        handleMurcielagoAI(i, targetPosition);
+    } else {
+        applyMovementForce(i, moveDirection * 1.5f);
+
+        if (types[i] == EnemyType::ESQUELETO && grounded[i] && std::abs(direction.y) > 30.0f) {
+            jump(i);
+        }
+    }
+}
+
+// IA especifica para murcielagos (vuelan)
+void CEnemyPool::handleMurcielagoAI(size_t i, const sf::Vector2f& playerPosition) {
+    if (!bodies[i]) return;
+
+    const EnemyTypeInfo& info = getTypeInfo(types[i]);
+    sf::Vector2f direction = playerPosition - positions[i];
+    float distance = distanceBetween(positions[i], playerPosition);
+
+    if (distance <= info.detectionRange * 1.5f && distance > info.attackRange) {
+        flyTowards(i, direction.x > 0 ? 1 : -1, direction.y > 0 ? 1 : -1);
+    }
+}
+
+void CEnemyPool::flyTowards(size_t i, int directionX, int directionY) {
+    if (!bodies[i]) return;
+
+    const EnemyTypeInfo& info = getTypeInfo(types[i]);
+    float forceX = directionX * info.movementForce;
+    float forceY = directionY * info.flyForce;
+
+    physics->applyForce(bodyHandles[i], forceX * 0.8f, forceY * 0.5f);
+    setMoving(i, true);
+
+    // Velocidad maxima
+    b2Vec2 velocity = velocities[i];
+    if (velocity.Length() > 10.0f) {
+        velocity.Normalize();
+        velocity *= 10.0f;
+        bodies[i]->SetLinearVelocity(velocity);
+        velocities[i] = velocity;
+    }
+}
+
+void CEnemyPool::patrol(size_t i) {
+    if (!bodies[i]) return;
+
+    applyMovementForce(i, static_cast<float>(movementDirections[i]) * 0.8f);
+    setMoving(i, true);
+}
+
+void CEnemyPool::jump(size_t i) {
+    float jumpForce = getTypeInfo(types[i]).jumpForce;
+    if (!bodies[i] || !grounded[i] || jumpForce <= 0.0f) {
+        return;
+    }
+
+    // El impulso cambia la velocidad al instante: refrescar la copia
+    physics->applyImpulse(bodyHandles[i], 0.0f, -jumpForce);
+    velocities[i] = bodies[i]->GetLinearVelocity();
+    grounded[i] = 0;
+}
+
+void CEnemyPool::fly(size_t i) {
+    const EnemyTypeInfo& info = getTypeInfo(types[i]);
+    if (!bodies[i] || !info.flyCapable) return;
+
+    physics->applyForce(bodyHandles[i], 0.0f, -info.flyForce);
+}
+
+void CEnemyPool::applyMovementForce(size_t i, float direction) {
+    if (!bodies[i] || direction == 0.0f) return;
+
+    const EnemyTypeInfo& info = getTypeInfo(types[i]);
+    float speedX = std::abs(velocities[i].x);
+
+    if (speedX < info.maxVelocity) {
+        physics->applyForce(bodyHandles[i], direction * info.movementForce * 1.2f, 0.0f);
+    }
+
+    // Impulso adicional si esta casi parado
+    if (speedX < 0.5f) {
+        physics->applyForce(bodyHandles[i], direction * info.movementForce * 2.0f, 0.0f);
+    }
+}
+
+int CEnemyPool::attack(size_t i) {
+    if (health[i] <= 0 || cooldowns[i] > 0.0f) {
+        return 0;
+    }
+
+    const EnemyTypeInfo& info = getTypeInfo(types[i]);
+    std::cout << info.name << " ataca causando " << info.damage << " de dano!\n";
+    cooldowns[i] = info.attackCooldown;
+    return info.damage;
+}
+
+void CEnemyPool::takeDamage(size_t i, int damage) {
+    if (damage <= 0) return;
+
+    const EnemyTypeInfo& info = getTypeInfo(types[i]);
+    health[i] -= damage;
+    if (health[i] < 0) {
+        health[i] = 0;
+    }
+
+    std::cout << info.name << " recibe " << damage << " de dano. Salud: "
+              << health[i] << "/" << info.maxHealth << "\n";
+
+    if (health[i] > 0) {
+        fillColors[i] = sf::Color::Red;
+    } else {
+        fillColors[i] = sf::Color::Black;
+        setMoving(i, false);
+        std::cout << info.name << " ha muerto!\n";
+    }
+}
+
+void CEnemyPool::setMoving(size_t i, bool isMoving) {
+    if (static_cast<bool>(moving[i]) == isMoving) {
+        return;
+    }
+    moving[i] = isMoving ? 1 : 0;
+
+    // El murcielago siempre usa la animacion de vuelo
+    if (types[i] == EnemyType::MURCIELAGO) {
+        states[i] = EnemyState::MOVING;
+        return;
+    }
+
+    EnemyState newState = isMoving ? EnemyState::MOVING : EnemyState::IDLE;
+    if (states[i] != newState) {
+        states[i] = newState;
+        frames[i] = 0;
+        animationTimers[i] = 0.0f;
+        updateSpriteFrame(i);
+    }
+}
+
+void CEnemyPool::setPosition(size_t i, const sf::Vector2f& position) {
+    positions[i] = position;
+}
+
+void CEnemyPool::updatePhysicsPosition(size_t i) {
+    if (!bodies[i]) return;
+
+    bodies[i]->SetTransform(CPhysics::sfmlVecToB2(positions[i]), bodies[i]->GetAngle());
+
+    // Evitar que la interpolacion arrastre el sprite desde la posicion anterior
+    physics->resetInterpolation(bodyHandles[i]);
+}
+
+// ANIMACION
+void CEnemyPool::resolveFrameTables(EnemyType type) {
+    const EnemyTypeInfo& info = getTypeInfo(type);
+    std::vector<AtlasFrame>* tables = frameTables[static_cast<int>(type)];
+    std::vector<AtlasFrame>& idleFrames = tables[static_cast<int>(EnemyState::IDLE)];
+    std::vector<AtlasFrame>& movingFrames = tables[static_cast<int>(EnemyState::MOVING)];
+
+    // Primero el atlas; si el tipo no está empaquetado, su hoja suelta desde el cache
+    const CTextureAtlas& atlas = CTextureAtlas::getInstance();
+    if (atlas.getStripFrames(getStripName(type, EnemyState::IDLE), idleFrames) &&
+        atlas.getStripFrames(getStripName(type, EnemyState::MOVING), movingFrames)) {
+        return;
+    }
+
+    TextureHandle& texture = typeTextures[static_cast<int>(type)];
+    if (!texture) {
+        texture = CTextureCache::getInstance().acquire(info.texturePath);
+    }
+
+    const EnemySheetStrip& idle = info.idleStrip;
+    const EnemySheetStrip& move = info.movingStrip;
+    CTextureAtlas::sliceStrip(texture.get(), {"", idle.startX, idle.startY, idle.frameCount, idle.frameWidth, idle.frameHeight}, idleFrames);
+    CTextureAtlas::sliceStrip(texture.get(), {"", move.startX, move.startY, move.frameCount, move.frameWidth, move.frameHeight}, movingFrames);
+}
+
+const std::vector<AtlasFrame>& CEnemyPool::getCurrentFrames(size_t i) const {
+    return frameTables[static_cast<int>(types[i])][static_cast<int>(states[i])];
+}
+
+sf::IntRect CEnemyPool::getFrameRect(size_t i) const {
+    return getCurrentFrames(i)[frames[i]].rect;
+}
+
+void CEnemyPool::updateSpriteFrame(size_t i) {
+    if (!textured[i]) return;
+
+    // Un tipo puede repartir sus frames entre páginas del atlas: cambiar de textura solo si hace falta
+    const AtlasFrame& frame = getCurrentFrames(i)[frames[i]];
+    if (sprites[i].getTexture() != frame.texture) {
+        sprites[i].setTexture(*frame.texture);
+    }
+    sprites[i].setTextureRect(frame.rect);
+}
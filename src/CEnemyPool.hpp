@@ -0,0 +1,258 @@
+#ifndef CENEMYPOOL_HPP
+#define CENEMYPOOL_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+#include "CPhysics.hpp"
+#include "CSlotMap.hpp"
+#include "CTextureCache.hpp"
+#include "CSpriteBatch.hpp"
+#include "CTextureAtlas.hpp"
+#include "CAIScheduler.hpp"
+
+class CEnemy;
+
+enum class EnemyType {
+    MURCIELAGO,
+    ESQUELETO,
+    ZOMBIE
+};
+
+// ===================================
+// NUEVO: Estados de animación para enemigos
+// ===================================
+enum class EnemyState {
+    IDLE,      // Parado (frame único)
+    MOVING     // En movimiento (animación)
+};
+
+static const int ENEMY_TYPE_COUNT = 3;
+
+// Hoja de sprites de un estado: origen del primer frame, tamaño y número de frames
+struct EnemySheetStrip {
+    int startX;
+    int startY;
+    int frameCount;
+    int frameWidth;
+    int frameHeight;
+};
+
+// Datos constantes de cada tipo de enemigo (se comparten, no se copian en cada instancia)
+struct EnemyTypeInfo {
+    std::string name;
+    std::string texturePath;
+    int maxHealth;
+    int damage;
+    float speed;
+    float detectionRange;
+    float attackRange;
+    float attackCooldown;
+    sf::Color color;
+
+    // Animación (animationSpeed: segundos por frame, más alto = más lento)
+    float animationSpeed;
+    EnemySheetStrip idleStrip;
+    EnemySheetStrip movingStrip;
+    sf::Vector2f spriteScale;
+
+    // Físicas
+    bool flyCapable;
+    float jumpForce;
+    float flyForce;
+    float movementForce;
+    float maxVelocity;       // Velocidad horizontal máxima (m/s)
+};
+
+// Acción que decide la IA de un enemigo en un tick
+enum class AIAction : uint8_t {
+    NONE,           // Nada (murciélago encima del jugador esperando el cooldown)
+    IDLE,           // Pararse
+    ATTACK,
+    CHASE,          // Fuerza horizontal hacia el jugador y, si procede, salto
+    FLY,            // Murciélago: fuerza en x e y hacia el jugador
+    PATROL,         // Fuerza en la dirección de patrullaje (la dirección se fija al aplicar)
+    MOVE_TOWARDS    // Sin físicas: mover la posición directamente
+};
+
+// Decisión de IA de un enemigo. Se calcula leyendo solo el pool y la posición del
+// jugador (puede hacerse en paralelo) y se aplica después en el hilo principal
+struct AICommand {
+    uint32_t index;          // Índice denso
+    float elapsed;           // Segundos desde su último tick de IA
+    AIAction action;
+    int8_t directionX;       // CHASE y FLY: hacia el jugador (-1 o 1)
+    int8_t directionY;       // FLY
+    uint8_t jump;            // CHASE: intentar saltar
+    float thrust;            // CHASE: multiplicador de la fuerza de movimiento
+};
+
+// Identificador estable de un enemigo del pool (sobrevive a los swap-and-pop internos)
+using EnemyId = SlotHandle<CEnemy>;
+
+// ===============================================
+// Pool de enemigos en estructura de arrays (SoA)
+// ===============================================
+// El estado que tocan todos los frames (posición, velocidad, salud, cooldown,
+// animación, tipo...) vive en arrays paralelos y contiguos, indexados por la
+// posición densa del enemigo. Los bucles de IA, update y animación recorren
+// esos arrays en orden, sin saltar por punteros. Lo que solo se usa al dibujar
+// o al hablar con Box2D (sprites, cuerpos) va en arrays aparte para no ensuciar
+// la caché del bucle caliente. CEnemy es una vista fina (pool + EnemyId).
+//
+// LOD por distancia: los enemigos activos ocupan el tramo [0, activeCount) de
+// los arrays y los congelados (lejos del jugador) el resto. Un congelado tiene
+// el cuerpo deshabilitado en Box2D (fuera del broadphase y sin contactos), no
+// se sincroniza ni se anima, y su IA barata (cooldown y patrullaje) se ejecuta
+// por turnos: cada frame solo una fracción de ellos, con el tiempo acumulado.
+// Así el coste por frame depende de cuántos hay cerca, no del total. La IA de
+// los activos también se escalona por distancia (ver CAIScheduler).
+class CEnemyPool {
+    friend class CEnemy;
+
+private:
+    // Indirección id -> índice denso (mismo esquema que CSlotMap)
+    std::vector<uint32_t> slotDense;
+    std::vector<uint32_t> slotGeneration;
+    std::vector<uint32_t> denseSlot;
+    uint32_t freeHead;
+
+    // LOD y planificación de la IA
+    size_t activeCount;                        // Los primeros activeCount índices están activos
+    size_t frozenCursor;                       // Siguiente congelado al que le toca tick
+    double aiClock;                            // Tiempo acumulado por updateAI()
+    uint8_t nextPhase;
+    CAIScheduler aiScheduler;
+    std::vector<size_t> bucketIndices[AI_BUCKET_COUNT];    // Reparto del frame, reutilizado entre frames
+    std::vector<AICommand> aiCommands;         // Decisiones del cubo en curso
+
+    // DATOS CALIENTES
+    std::vector<EnemyType> types;
+    std::vector<sf::Vector2f> positions;       // Píxeles (esquina superior izquierda)
+    std::vector<b2Vec2> velocities;            // m/s, copia de la del cuerpo tras cada paso
+    std::vector<int> health;
+    std::vector<float> cooldowns;
+    std::vector<float> directionTimers;
+    std::vector<int8_t> movementDirections;
+    std::vector<uint8_t> grounded;
+    std::vector<uint8_t> moving;
+    std::vector<EnemyState> states;
+    std::vector<uint8_t> frames;
+    std::vector<float> animationTimers;
+    std::vector<double> aiTicks;               // aiClock en el último tick de IA
+    std::vector<uint8_t> aiPhases;             // Fase en el planificador (turno rotatorio al spawnear)
+    std::vector<AICommand> sustainedCommands;  // Última decisión: su fuerza se reaplica cada frame hasta la siguiente
+
+    // DATOS FRIOS
+    std::vector<CEnemy*> owners;               // Vista asociada (userData del cuerpo)
+    std::vector<BodyHandle> bodyHandles;
+    std::vector<b2Body*> bodies;               // nullptr si no tiene físicas
+    std::vector<sf::Sprite> sprites;
+    std::vector<uint8_t> textured;
+    std::vector<sf::Color> fillColors;         // Color del rectángulo de respaldo (parpadeo al recibir daño)
+
+    CPhysics* physics;
+    std::vector<BodyHandle> spareBodies[ENEMY_TYPE_COUNT]; // Cuerpos deshabilitados listos para reutilizar, por tipo
+    size_t bodiesCreated;
+    size_t bodiesRecycled;
+    TextureHandle typeTextures[ENEMY_TYPE_COUNT];          // Solo si el tipo no está en el atlas
+    std::vector<AtlasFrame> frameTables[ENEMY_TYPE_COUNT][2]; // [tipo][EnemyState]: textura + rectángulo de cada frame
+    sf::RectangleShape fallbackShape;          // Rectángulo reutilizado por renderAt() para enemigos sin textura
+
+public:
+    static constexpr float DIRECTION_CHANGE_TIME = 3.0f;   // Patrullaje: segundos entre cambios de dirección
+    static constexpr float FALLBACK_SIZE = 28.0f;
+    static constexpr float WAKE_DISTANCE = 700.0f;         // Píxeles: más cerca se despierta (la vista mide 800x600)
+    static const size_t PARALLEL_AI_THRESHOLD = 512;       // Ticks en un cubo a partir de los que se decide en paralelo
+    static const size_t AI_BATCH_SIZE = 128;               // Enemigos por tarea del CJobSystem
+    static constexpr float FREEZE_DISTANCE = 900.0f;       // Píxeles: más lejos se congela (histéresis con WAKE_DISTANCE)
+
+    CEnemyPool();
+
+    static const EnemyTypeInfo& getTypeInfo(EnemyType type);
+    static void warmUpTextures();               // Precargar las texturas de todos los tipos
+    static void registerAtlasSheets();          // Registrar las hojas de todos los tipos en CTextureAtlas
+    static std::string getStripName(EnemyType type, EnemyState state);
+
+    // Gestión
+    EnemyId spawn(EnemyType type, float x, float y, CEnemy* owner = nullptr);
+    void release(EnemyId id);                   // Destruye también su cuerpo físico
+    bool contains(EnemyId id) const;
+    size_t indexOf(EnemyId id) const;           // Solo válido si contains(id)
+    size_t size() const;
+    void reserve(size_t capacity);
+
+    // Físicas. Los cuerpos no se destruyen al soltarlos: se deshabilitan y se
+    // guardan por tipo para el siguiente attachPhysics() (sin pasar por Box2D)
+    void setPhysics(CPhysics* physics);
+    bool attachPhysics(size_t index);           // Reutiliza un cuerpo aparcado si lo hay
+    void releasePhysics(size_t index);          // Aparca el cuerpo
+    void preallocateBodies(EnemyType type, size_t count);  // Hasta tener count aparcados de ese tipo
+    void destroySpareBodies();                  // Antes de destruir el mundo o descargar el nivel
+    size_t getSpareBodyCount() const;
+    size_t getBodiesCreated() const { return bodiesCreated; }
+    size_t getBodiesRecycled() const { return bodiesRecycled; }
+
+    // Bucles por lotes sobre todos los enemigos vivos
+    void updateAI(const sf::Vector2f& playerPosition, float deltaTime);  // Por cubos (activos y congelados)
+    void update(float deltaTime);                // Cooldowns, suelo, animación y parpadeo de daño
+    void syncFromPhysics();
+    void render(CSpriteBatch& batch);            // Añade un quad por enemigo (agrupados por textura)
+    void render(CSpriteBatch& batch, const std::vector<size_t>& indices);  // Solo esos índices (los visibles)
+
+    // LOD: update y syncFromPhysics solo recorren los activos
+    void wake(size_t index);                    // Si estaba congelado: reactiva el cuerpo y pasa a activos
+    void freezeDistant(const sf::Vector2f& playerPosition);  // Congela los activos más allá de FREEZE_DISTANCE
+    bool isActiveAt(size_t index) const { return index < activeCount; }
+    size_t getActiveCount() const { return activeCount; }
+    size_t getFrozenCount() const { return types.size() - activeCount; }
+    const CAIScheduler& getAIScheduler() const { return aiScheduler; }
+
+    // Operaciones sobre un enemigo (índice denso)
+    void updateAIAt(size_t index, const sf::Vector2f& playerPosition, float deltaTime);  // decideAt + applyCommand
+    AICommand decideAt(size_t index, const sf::Vector2f& playerPosition, float elapsed) const;  // Solo lee
+    void applyCommand(const AICommand& command, const sf::Vector2f& playerPosition);
+    void updateAt(size_t index, float deltaTime);
+    void syncFromPhysicsAt(size_t index);
+    void renderAt(size_t index, sf::RenderTarget& target);
+    void renderAt(size_t index, CSpriteBatch& batch);
+
+    bool isAliveAt(size_t index) const { return health[index] > 0; }
+    CEnemy* getOwnerAt(size_t index) const { return owners[index]; }
+    const sf::Vector2f& getPositionAt(size_t index) const { return positions[index]; }
+    sf::FloatRect getBoundsAt(size_t index) const;
+
+private:
+    void updateAnimationAt(size_t index, float deltaTime);
+    void swapEntries(size_t a, size_t b);       // Intercambia dos enemigos en todas las columnas
+    void freezeAt(size_t index);
+    void updateBucket(AIBucket bucket, const sf::Vector2f& playerPosition);
+    void sustainCommand(size_t index);          // Fuerza de la última decisión en los frames sin tick de IA
+    void decideCommands(const sf::Vector2f& playerPosition);  // Rellena aiCommands (en paralelo si son muchos)
+    void updateFrozen();                        // Tick de IA de una fracción de los congelados
+    void updateFrozenAt(size_t index, float elapsed);
+
+    // IA (índice denso)
+    void moveTowards(size_t index, const sf::Vector2f& targetPosition, float deltaTime);
+    void moveWithPhysics(size_t index, const sf::Vector2f& targetPosition);
+    void handleMurcielagoAI(size_t index, const sf::Vector2f& playerPosition);
+    void flyTowards(size_t index, int directionX, int directionY);
+    void patrol(size_t index);
+    void jump(size_t index);
+    void fly(size_t index);
+    void applyMovementForce(size_t index, float direction);
+    int attack(size_t index);
+    void takeDamage(size_t index, int damage);
+    void setMoving(size_t index, bool isMoving);
+    void setPosition(size_t index, const sf::Vector2f& position);
+    void updatePhysicsPosition(size_t index);
+
+    void resolveFrameTables(EnemyType type);
+    const std::vector<AtlasFrame>& getCurrentFrames(size_t index) const;
+    sf::IntRect getFrameRect(size_t index) const;
+    void updateSpriteFrame(size_t index);
+};
+
+#endif // CENEMYPOOL_HPP
@@ -0,0 +1,44 @@
+#include "CEventBus.hpp"
+#include "CTraceWriter.hpp"
+#include <utility>
+
+CEventBus::CEventBus()
+    : dispatchedCount(0) {
+    queue.reserve(INITIAL_CAPACITY);
+    dispatching.reserve(INITIAL_CAPACITY);
+}
+
+void CEventBus::subscribe(GameEventType type, Handler handler) {
+    handlers[static_cast<int>(type)].push_back(std::move(handler));
+}
+
+void CEventBus::clear() {
+    for (std::vector<Handler>& list : handlers) {
+        list.clear();
+    }
+    queue.clear();
+}
+
+void CEventBus::publish(GameEventType type, int32_t subject, int32_t amount, int32_t health) {
+    if (!hasSubscribers(type)) return;
+
+    queue.push_back(GameEvent{type, subject, amount, health});
+}
+
+void CEventBus::dispatch() {
+    if (queue.empty()) return;
+
+    TRACE_SCOPE("CEventBus::dispatch");
+
+    for (int pass = 0; pass < MAX_PASSES && !queue.empty(); pass++) {
+        // Los suscriptores pueden publicar: lo nuevo va a queue y sale en la siguiente ronda
+        dispatching.swap(queue);
+        for (const GameEvent& event : dispatching) {
+            for (const Handler& handler : handlers[static_cast<int>(event.type)]) {
+                handler(event);
+            }
+        }
+        dispatchedCount += dispatching.size();
+        dispatching.clear();
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef CEVENTBUS_HPP
+#define CEVENTBUS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Eventos de juego
+enum class GameEventType : uint8_t {
+    ENEMY_SPAWNED,       // subject: EnemyType
+    ENEMY_DAMAGED,       // subject: EnemyType, amount: daño, health: salud que le queda (0: muerto)
+    ENEMY_KILLED,        // subject: EnemyType (al retirarlo del nivel)
+    PLAYER_DAMAGED,      // amount: daño, health: salud que le queda (0: muerto)
+    LEVEL_COMPLETED,     // subject: número de nivel
+    STATE_CHANGED,       // subject: GameState nuevo, amount: GameState anterior
+    COUNT
+};
+
+const int GAME_EVENT_TYPE_COUNT = static_cast<int>(GameEventType::COUNT);
+
+struct GameEvent {
+    GameEventType type;
+    int32_t subject;
+    int32_t amount;
+    int32_t health;
+};
+
+// ===============================================
+// Bus de eventos de juego
+// ===============================================
+// Los módulos publican lo que ha pasado (un spawn, un golpe, un cambio de
+// estado) y CGame lo reparte una vez por frame con dispatch(), en el orden en
+// que se publicó: HUD, música, puntuación y telemetría solo trabajan cuando
+// hay algo nuevo, sin consultar cada frame. Un evento sin suscriptores no se
+// encola, así que publicar fuera del juego (benchmarks, niveles sueltos) no
+// cuesta nada. Lo que publiquen los suscriptores durante el reparto se
+// entrega en el mismo dispatch() (hasta MAX_PASSES rondas; lo que sobre, en el
+// siguiente). Solo desde el hilo principal.
+class CEventBus {
+public:
+    using Handler = std::function<void(const GameEvent&)>;
+
+    static const int MAX_PASSES = 4;
+    static const size_t INITIAL_CAPACITY = 256;
+
+private:
+    std::array<std::vector<Handler>, GAME_EVENT_TYPE_COUNT> handlers;
+    std::vector<GameEvent> queue;
+    std::vector<GameEvent> dispatching;          // Lote que se está repartiendo (se intercambia con queue)
+    size_t dispatchedCount;
+
+    CEventBus();
+
+public:
+    CEventBus(const CEventBus&) = delete;
+    CEventBus& operator=(const CEventBus&) = delete;
+
+    static CEventBus& getInstance() {
+        static CEventBus instance;
+        return instance;
+    }
+
+    void subscribe(GameEventType type, Handler handler);
+    void clear();                                // Quita suscriptores y eventos pendientes
+
+    void publish(GameEventType type, int32_t subject = 0, int32_t amount = 0, int32_t health = 0);
+    void dispatch();                             // Reparte todo lo publicado desde el anterior
+
+    bool hasSubscribers(GameEventType type) const { return !handlers[static_cast<int>(type)].empty(); }
+    size_t getPendingCount() const { return queue.size(); }
+    size_t getDispatchedCount() const { return dispatchedCount; }
+};
+
+#endif // CEVENTBUS_HPP
@@ -2,19 +2,21 @@
 #include <iostream>
 #include <cmath>
 #include "CMusica.hpp"
+#include "CRandom.hpp"
+#include "CProfiler.hpp"
+#include "CTextureAtlas.hpp"
 
 // Constructor
 CGame::CGame() 
     : gameState(GameState::MENU), running(false), fontLoaded(false),
-      currentLevelIndex(0), inputCooldown(0.0f), playerSpeed(150.0f),
-      jumpForce(12.0f), attackRange(50.0f), attackDamage(25), totalScore(0),
+      headless(false), inputScript(nullptr), currentTick(0),
+      randomSeed(CRandom::DEFAULT_SEED), replayDiverged(false),
+      tickAccumulator(0.0f),
+      currentLevelIndex(0), pendingLevelIndex(-1), inputCooldown(0.0f), playerSpeed(150.0f),
+      jumpForce(12.0f), attackRange(50.0f), attackDamage(25),
+      physicsStepRate(60.0f), physicsMaxSubSteps(5), hudDirty(true), totalScore(0),
       levelsCompleted(0), totalPlayTime(0.0f),
       musica(nullptr) { 
-    
-    // Inicializar array de teclas
-    for (int i = 0; i < sf::Keyboard::KeyCount; i++) {
-        keyPressed[i] = false;
-    }
 }
 
 // Destructor
@@ -26,7 +28,12 @@ CGame::~CGame() {
 void CGame::run() {
     initialize();
     
+    CProfiler& profiler = CProfiler::getInstance();
+    
     while (running && window.isOpen()) {
+        TRACE_SCOPE("frame");
+        profiler.beginFrame();
+        
         float deltaTime = clock.restart().asSeconds();
         
         // Limitar deltaTime para evitar saltos grandes
@@ -35,32 +42,268 @@ void CGame::run() {
         }
         
         handleEvents();
-        handleInput(deltaTime);
-        update(deltaTime);
+        
+        if (isLockstep()) {
+            // Grabando o reproduciendo: la logica avanza en ticks fijos para ser reproducible
+            runLockstepTicks(deltaTime);
+        } else {
+            sampleInput(deltaTime);
+            handleInput(deltaTime);
+            update(deltaTime);
+        }
+        
         render();
+        
+        profiler.endFrame();
+    }
+    
+    finishSession();
+    cleanup();
+}
+
+void CGame::runHeadless(CInputScript& script, long maxTicks) {
+    headless = true;
+    inputScript = &script;
+    
+    initialize();
+    
+    sf::Clock wallClock;
+    
+    CProfiler& profiler = CProfiler::getInstance();
+    
+    while (running && currentTick < maxTicks) {
+        TRACE_SCOPE("tick");
+        profiler.beginFrame();
+        simulateTick();
+        profiler.endFrame();
     }
     
+    printHeadlessSummary(wallClock.getElapsedTime().asSeconds());
+    if (profiler.isEnabled()) {
+        profiler.printSummary();
+    }
+    finishSession();
+    
+    inputScript = nullptr;
     cleanup();
 }
 
+bool CGame::isHeadless() const {
+    return headless;
+}
+
+// GRABACION Y REPRODUCCION
+void CGame::setRandomSeed(uint32_t seed) {
+    randomSeed = seed;
+}
+
+void CGame::setAtlasDumpPrefix(const std::string& prefix) {
+    atlasDumpPrefix = prefix;
+}
+
+void CGame::startRecording(const std::string& path) {
+    recording = std::make_unique<CReplay>();
+    recordingPath = path;
+}
+
+bool CGame::loadReplay(const std::string& path) {
+    auto loaded = std::make_unique<CReplay>();
+    if (!loaded->loadFromFile(path)) {
+        return false;
+    }
+    
+    replay = std::move(loaded);
+    replayDiverged = false;
+    return true;
+}
+
+long CGame::getReplayLength() const {
+    return replay ? static_cast<long>(replay->getTickCount()) : 0;
+}
+
+bool CGame::hasReplayDiverged() const {
+    return replayDiverged;
+}
+
+bool CGame::isLockstep() const {
+    return headless || recording || replay;
+}
+
+void CGame::runLockstepTicks(float deltaTime) {
+    float tickDeltaTime = physics->getFixedTimeStep();
+    tickAccumulator += deltaTime;
+    
+    int ticks = 0;
+    while (running && tickAccumulator >= tickDeltaTime && ticks < physicsMaxSubSteps) {
+        simulateTick();
+        tickAccumulator -= tickDeltaTime;
+        ticks++;
+    }
+    
+    // Si no damos abasto se descarta el tiempo sobrante (la partida se ralentiza, no diverge)
+    if (ticks == physicsMaxSubSteps) {
+        tickAccumulator = std::fmod(tickAccumulator, tickDeltaTime);
+    }
+}
+
+void CGame::simulateTick() {
+    // Cada tick avanza exactamente un paso fijo de fisicas
+    float tickDeltaTime = physics->getFixedTimeStep();
+    
+    sampleInput(tickDeltaTime);
+    handleInput(tickDeltaTime);
+    update(tickDeltaTime);
+    
+    currentTick++;
+    updateReplayCheckpoints();
+    
+    if (replay && currentTick >= static_cast<long>(replay->getTickCount())) {
+        running = false;
+    }
+}
+
+void CGame::sampleInput(float deltaTime) {
+    InputMask mask = 0;
+    if (replay) {
+        mask = replay->getInput(currentTick);
+    } else if (headless) {
+        if (inputScript) {
+            inputScript->advanceTo(currentTick);
+            mask = input.getScriptMask(*inputScript);
+        }
+    } else {
+        // Eventos de teclado recibidos en handleEvents desde el tick anterior
+        mask = input.takeLiveMask();
+    }
+    
+    if (recording) {
+        recording->recordTick(mask);
+    }
+    
+    input.advance(mask, deltaTime);
+}
+
+void CGame::updateReplayCheckpoints() {
+    if (currentTick % CReplay::CHECKPOINT_INTERVAL != 0) return;
+    if (!recording && !replay) return;
+    
+    uint64_t stateHash = computeStateHash();
+    
+    if (recording) {
+        recording->addCheckpoint(static_cast<uint32_t>(currentTick), stateHash);
+    }
+    
+    if (replay && !replayDiverged) {
+        const ReplayCheckpoint* checkpoint = replay->findCheckpoint(static_cast<uint32_t>(currentTick));
+        if (checkpoint && checkpoint->stateHash != stateHash) {
+            replayDiverged = true;
+            std::cerr << "Replay: DIVERGENCIA en el tick " << currentTick << std::endl;
+        }
+    }
+}
+
+void CGame::finishSession() {
+    if (recording) {
+        // Checkpoint final aunque el ultimo tick no caiga en el intervalo
+        if (currentTick % CReplay::CHECKPOINT_INTERVAL != 0) {
+            recording->addCheckpoint(static_cast<uint32_t>(currentTick), computeStateHash());
+        }
+        recording->saveToFile(recordingPath);
+        recording.reset();
+    }
+    
+    if (replay) {
+        const ReplayCheckpoint* finalCheckpoint = replay->findCheckpoint(static_cast<uint32_t>(currentTick));
+        if (finalCheckpoint && finalCheckpoint->stateHash != computeStateHash()) {
+            replayDiverged = true;
+        }
+        
+        std::cout << "Replay: " << currentTick << "/" << replay->getTickCount() << " ticks, "
+                  << replay->getCheckpointCount() << " checkpoints -> "
+                  << (replayDiverged ? "DIVERGENTE" : "identico") << std::endl;
+        replay.reset();
+    }
+}
+
+uint64_t CGame::computeStateHash() const {
+    uint64_t hash = CReplay::HASH_SEED;
+    
+    hash = CReplay::hashValue(hash, currentTick);
+    hash = CReplay::hashValue(hash, gameState);
+    hash = CReplay::hashValue(hash, currentLevelIndex);
+    hash = CReplay::hashValue(hash, totalScore);
+    hash = CReplay::hashValue(hash, CRandom::getGlobal().getState());
+    
+    if (player) {
+        hash = CReplay::hashValue(hash, player->getHealth());
+        
+        b2Body* body = player->getPhysicsBody();
+        if (body) {
+            hash = CReplay::hashValue(hash, body->GetPosition());
+            hash = CReplay::hashValue(hash, body->GetLinearVelocity());
+        }
+    }
+    
+    if (getActiveLevel()) {
+        hash = getActiveLevel()->hashState(hash);
+    }
+    
+    return hash;
+}
+
 // GAME STATE MANAGEMENT
 void CGame::initialize() {
-    initializeWindow();
-    loadResources();
+    // En headless no se crea ventana ni se cargan texturas: las entidades usan su fallback
+    CTextureCache::getInstance().setLoadingEnabled(!headless);
+    
+    if (!headless) {
+        initializeWindow();
+        loadResources();
+        // Controles del jugador (opcional); headless usa siempre los de por defecto para que los scripts no cambien
+        input.loadBindings("assets/controls.txt");
+    }
     setupGameSettings();
-    setupUI();
+    if (!headless) {
+        setupUI();
+    }
+    
+    // Un replay solo es reproducible con su semilla y su paso fijo
+    if (replay) {
+        randomSeed = replay->getSeed();
+        physicsStepRate = static_cast<float>(replay->getStepRate());
+        
+        bool recordedHeadless = (replay->getFlags() & CReplay::FLAG_HEADLESS) != 0;
+        if (recordedHeadless != headless) {
+            std::cerr << "Replay: grabado " << (recordedHeadless ? "en headless" : "con ventana")
+                      << "; el resultado puede diferir (bounds de los enemigos)" << std::endl;
+        }
+    }
+    CRandom::getGlobal().setSeed(randomSeed);
     
     // Sistema de fisicas
     initializePhysics();
    
-    initializeMusic();
+    if (!headless) {
+        initializeMusic();
+    }
     
     createLevels();
+    subscribeToEvents();
+    
+    // El primer nivel se prepara mientras se muestra el menu
+    preloadLevel(0);
     
     running = true;
     gameState = GameState::MENU;
+    currentTick = 0;
+    tickAccumulator = 0.0f;
     
-    std::cout << "CGame: Sistema inicializado exitosamente." << std::endl;
+    if (recording) {
+        recording->begin(randomSeed, static_cast<uint32_t>(physicsStepRate),
+                         headless ? CReplay::FLAG_HEADLESS : 0);
+    }
+    
+    std::cout << "CGame: Sistema inicializado exitosamente" << (headless ? " (headless)." : ".") << std::endl;
 }
 
 void CGame::initializeMusic() {
@@ -79,7 +322,11 @@ void CGame::initializePhysics() {
     
     if (!physics) {
         std::cerr << "Error: No se pudo inicializar el sistema de fisicas" << std::endl;
+        return;
     }
+    
+    // Simulacion a paso fijo: coste y resultado independientes del framerate
+    physics->setFixedTimestep(physicsStepRate, physicsMaxSubSteps);
 }
 
 void CGame::cleanup() {
@@ -87,6 +334,14 @@ void CGame::cleanup() {
         window.close();
     }
     
+    // El hilo de precarga no toca los niveles, pero no debe sobrevivir al juego
+    if (pendingLayout.valid()) {
+        pendingLayout.wait();
+    }
+    
+    // Los suscriptores apuntan a este CGame
+    CEventBus::getInstance().clear();
+    
     player.reset();
     levels.clear();
     
@@ -137,22 +392,22 @@ void CGame::startNewGame() {
     // Cargar primer nivel
     if (!levels.empty()) {
         loadLevel(0);
-        gameState = GameState::PLAYING;
+        setGameState(GameState::PLAYING);
     } else {
         std::cerr << "Error: No hay niveles disponibles!" << std::endl;
-        gameState = GameState::GAME_OVER;
+        setGameState(GameState::GAME_OVER);
     }
 }
 
 void CGame::pauseGame() {
     if (gameState == GameState::PLAYING) {
-        gameState = GameState::PAUSED;
+        setGameState(GameState::PAUSED);
     }
 }
 
 void CGame::resumeGame() {
     if (gameState == GameState::PAUSED) {
-        gameState = GameState::PLAYING;
+        setGameState(GameState::PLAYING);
     }
 }
 
@@ -166,7 +421,8 @@ void CGame::restartLevel() {
                 player->updatePhysicsPosition();
             }
         }
-        gameState = GameState::PLAYING;
+        hudDirty = true;
+        setGameState(GameState::PLAYING);
     }
 }
 
@@ -176,18 +432,20 @@ void CGame::nextLevel() {
     
     if (currentLevelIndex < static_cast<int>(levels.size())) {
         loadLevel(currentLevelIndex);
-        gameState = GameState::PLAYING;
+        setGameState(GameState::PLAYING);
     } else {
-        gameState = GameState::VICTORY;
+        setGameState(GameState::VICTORY);
     }
 }
 
 void CGame::endGame() {
-    gameState = GameState::MENU;
+    setGameState(GameState::MENU);
 }
 
 // CORE GAME LOOP METHODS
 void CGame::handleEvents() {
+    PROFILE_ZONE(ProfileZone::HANDLE_EVENTS);
+    
     sf::Event event;
     while (window.pollEvent(event)) {
         switch (event.type) {
@@ -196,16 +454,16 @@ void CGame::handleEvents() {
                 break;
                 
             case sf::Event::KeyPressed:
-                // Manejar ESC para cerrar/pausar
-                if (event.key.code == sf::Keyboard::Escape) {
-                    if (gameState == GameState::PLAYING) {
-                        pauseGame();
-                    } else if (gameState == GameState::PAUSED) {
-                        resumeGame();
-                    } else {
-                        running = false;
-                    }
+                // F10 = overlay del profiler (no afecta a la simulacion, no se graba)
+                if (event.key.code == sf::Keyboard::F10) {
+                    CProfiler::getInstance().toggleOverlay();
                 }
+                input.handleEvent(event);
+                break;
+                
+            case sf::Event::KeyReleased:
+            case sf::Event::LostFocus:
+                input.handleEvent(event);
                 break;
                 
             default:
@@ -215,11 +473,19 @@ void CGame::handleEvents() {
 }
 
 void CGame::handleInput(float deltaTime) {
+    PROFILE_ZONE(ProfileZone::HANDLE_INPUT);
+    
     // Actualizar cooldown de input
     if (inputCooldown > 0.0f) {
         inputCooldown -= deltaTime;
     }
     
+    // La pausa se lee como el resto de acciones para que quede en las grabaciones
+    if (isActionJustPressed(InputAction::PAUSE)) {
+        handleEscapeKey();
+        return;
+    }
+    
     switch (gameState) {
         case GameState::MENU:
             processMenuInput();
@@ -233,8 +499,8 @@ void CGame::handleInput(float deltaTime) {
         case GameState::LEVEL_COMPLETED:
         case GameState::GAME_OVER:
         case GameState::VICTORY:
-            // Presionar cualquier tecla para continuar
-            if (isKeyJustPressed(sf::Keyboard::Space) || isKeyJustPressed(sf::Keyboard::Enter)) {
+            // Aceptar para continuar
+            if (isActionJustPressed(InputAction::CONFIRM)) {
                 if (gameState == GameState::LEVEL_COMPLETED) {
                     nextLevel();
                 } else {
@@ -255,37 +521,62 @@ void CGame::update(float deltaTime) {
         case GameState::PLAYING:
             updateGameplay(deltaTime);
             updatePhysics(deltaTime);
+            updateCamera(deltaTime);
             break;
         default:
             break;
     }
     
+    // Lo que ha pasado en este frame (golpes, muertes, cambios de estado) llega ahora a sus suscriptores
+    CEventBus::getInstance().dispatch();
+    
     updateMusic(deltaTime);
-    updateUI();
+    
+    if (!headless) {
+        updateUI();
+    }
 }
 
 void CGame::updatePhysics(float deltaTime) {
+    PROFILE_ZONE(ProfileZone::UPDATE_PHYSICS);
+    
     if (!physics) {
         std::cerr << "Warning: Sistema de fisicas no inicializado" << std::endl;
         return;
     }
     
+    // Acumula deltaTime y ejecuta 0..N pasos fijos
     physics->update(deltaTime);
     
-    // Sincronizar posiciones fisicas con visuales
+    // Sincronizar posiciones fisicas con visuales (interpoladas entre pasos)
     if (player && player->getPhysicsBody()) {
         player->syncPositionFromPhysics();
     }
+    
+    if (getActiveLevel()) {
+        getActiveLevel()->syncEnemiesFromPhysics();
+    }
+}
+
+void CGame::updateCamera(float deltaTime) {
+    if (!player) return;
+    
+    // Centro del jugador (ya interpolado por updatePhysics)
+    sf::FloatRect bounds = player->getBounds();
+    camera.follow(sf::Vector2f(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f), deltaTime);
 }
 
 void CGame::updateMusic(float deltaTime) {
+    PROFILE_ZONE(ProfileZone::UPDATE_MUSIC);
+    
     if (!musica) return;
     
     musica->update(deltaTime);
-    handleMusicStateChanges();
 }
 
 void CGame::render() {
+    PROFILE_ZONE(ProfileZone::RENDER);
+    
     window.clear(sf::Color::Black);
     
     switch (gameState) {
@@ -311,12 +602,14 @@ void CGame::render() {
             break;
     }
     
+    CProfiler::getInstance().renderOverlay(window, fontLoaded ? &font : nullptr);
+    
     window.display();
 }
 
 // INPUT PROCESSING
 void CGame::processMenuInput() {
-    if (isKeyJustPressed(sf::Keyboard::Enter) || isKeyJustPressed(sf::Keyboard::Space)) {
+    if (isActionJustPressed(InputAction::CONFIRM)) {
         startNewGame();
     }
 }
@@ -327,77 +620,80 @@ void CGame::processGameInput(float deltaTime) {
     handlePlayerMovement(deltaTime);
     handleMusicInput();
     
-    if (isKeyJustPressed(sf::Keyboard::I)) {
+    if (isActionJustPressed(InputAction::DEBUG_POSITIONS)) {
         debugPositions();
     }   
     
-    if (isKeyJustPressed(sf::Keyboard::W) || isKeyJustPressed(sf::Keyboard::Space)) {
-        handlePlayerJump();
+    // Salto y ataque desde el buffer: una pulsación que llega justo antes de tocar
+    // suelo o de acabar el cooldown se ejecuta en cuanto se puede
+    if (input.isBuffered(InputAction::JUMP) && inputCooldown <= 0.0f && handlePlayerJump()) {
+        input.consume(InputAction::JUMP);
     }
     
-    if (isKeyJustPressed(sf::Keyboard::Enter)) {
+    if (input.isBuffered(InputAction::ATTACK) && inputCooldown <= 0.0f && !player->isHurt()) {
         handlePlayerAttack();
+        input.consume(InputAction::ATTACK);
     }
     
-    if (isKeyJustPressed(sf::Keyboard::R)) {
+    if (isActionJustPressed(InputAction::RESTART)) {
         restartLevel();
     }
     
     // DEBUG CONTROLS
-    if (isKeyJustPressed(sf::Keyboard::P)) {
+    if (isActionJustPressed(InputAction::DEBUG_PHYSICS)) {
         debugFullPhysicsState();
     }
     
     // Controles de debug de plataformas
-    if (isKeyJustPressed(sf::Keyboard::F1)) {
+    if (isActionJustPressed(InputAction::DEBUG_PLATFORMS)) {
         debugShowPlatformPositions();
     }
     
-    if (isKeyJustPressed(sf::Keyboard::F2)) {
+    if (isActionJustPressed(InputAction::PLATFORM_UP)) {
         adjustPlatformOffset(0.0f, -5.0f);
     }
     
-    if (isKeyJustPressed(sf::Keyboard::F3)) {
+    if (isActionJustPressed(InputAction::PLATFORM_DOWN)) {
         adjustPlatformOffset(0.0f, 5.0f);
     }
     
-    if (isKeyJustPressed(sf::Keyboard::F4)) {
+    if (isActionJustPressed(InputAction::PLATFORM_LEFT)) {
         adjustPlatformOffset(-5.0f, 0.0f);
     }
     
-    if (isKeyJustPressed(sf::Keyboard::F5)) {
+    if (isActionJustPressed(InputAction::PLATFORM_RIGHT)) {
         adjustPlatformOffset(5.0f, 0.0f);
     }
     
-    if (isKeyJustPressed(sf::Keyboard::F6)) {
+    if (isActionJustPressed(InputAction::PLATFORM_RESET)) {
         resetPlatformOffsets();
     }
     
-    if (isKeyJustPressed(sf::Keyboard::F7)) {
+    if (isActionJustPressed(InputAction::PLATFORM_THICKER)) {
         CLevel* activeLevel = getActiveLevel();
         if (activeLevel) {
             activeLevel->adjustPlatformThickness(10.0f);   
         }
     }
     
-    if (isKeyJustPressed(sf::Keyboard::F8)) {
+    if (isActionJustPressed(InputAction::PLATFORM_THINNER)) {
         CLevel* activeLevel = getActiveLevel();
         if (activeLevel) {
             activeLevel->adjustPlatformThickness(-10.0f);  
         }
     }
     
-    if (isKeyJustPressed(sf::Keyboard::T)) {
+    if (isActionJustPressed(InputAction::PLATFORM_INFO)) {
         debugPlatformInfo();
     }
     
-    if (isKeyJustPressed(sf::Keyboard::Y)) {
+    if (isActionJustPressed(InputAction::REPOSITION_PLAYER)) {
         forcePlayerRepositioning();
     }
 }
 
 void CGame::processPauseInput() {
-    if (isKeyJustPressed(sf::Keyboard::R)) {
+    if (isActionJustPressed(InputAction::RESTART)) {
         restartLevel();
     }
 }
@@ -465,16 +761,29 @@ void CGame::resetPlatformOffsets() {
     }
 }
 
-bool CGame::isKeyJustPressed(sf::Keyboard::Key key) {
-    bool currentState = sf::Keyboard::isKeyPressed(key);
-    bool wasPressed = keyPressed[key];
-    keyPressed[key] = currentState;
-    
-    return currentState && !wasPressed && inputCooldown <= 0.0f;
+bool CGame::isActionJustPressed(InputAction action) const {
+    return input.wasPressed(action) && inputCooldown <= 0.0f;
+}
+
+bool CGame::isActionDown(InputAction action) const {
+    return input.isDown(action);
+}
+
+void CGame::handleEscapeKey() {
+    // Cerrar/pausar
+    if (gameState == GameState::PLAYING) {
+        pauseGame();
+    } else if (gameState == GameState::PAUSED) {
+        resumeGame();
+    } else {
+        running = false;
+    }
 }
 
 // GAME LOGIC
 void CGame::updateGameplay(float deltaTime) {
+    PROFILE_ZONE(ProfileZone::UPDATE_GAMEPLAY);
+    
     if (!player || !getActiveLevel()) return;
     
     // Actualizar jugador
@@ -484,11 +793,8 @@ void CGame::updateGameplay(float deltaTime) {
     // Actualizar nivel actual
     getActiveLevel()->update(deltaTime, player->getPosition());
     
-    // Verificar colisiones
+    // Verificar colisiones (la muerte del jugador y el fin del nivel llegan como eventos)
     checkCollisions();
-    
-    // Actualizar estado del juego
-    updateGameState();
 }
 
 void CGame::checkCollisions() {
@@ -530,19 +836,53 @@ void CGame::checkAttackCollisions() {
     // Por ahora es un placeholder para el sistema de ataque
 }
 
-void CGame::updateGameState() {
-    if (!player || !getActiveLevel()) return;
+void CGame::setGameState(GameState state) {
+    if (gameState == state) return;
     
-    // Verificar si el jugador murio
-    if (!player->isAlive()) {
-        gameState = GameState::GAME_OVER;
-        return;
+    GameState previous = gameState;
+    gameState = state;
+    input.clearBuffers();  // El Enter/Espacio que acepta un menú no ataca ni salta al entrar
+    CEventBus::getInstance().publish(GameEventType::STATE_CHANGED, static_cast<int32_t>(state), static_cast<int32_t>(previous));
+}
+
+// EVENTOS
+void CGame::subscribeToEvents() {
+    CEventBus& bus = CEventBus::getInstance();
+    
+    bus.subscribe(GameEventType::STATE_CHANGED, [this](const GameEvent& event) {
+        handleMusicStateChanges(static_cast<GameState>(event.subject));
+    });
+    bus.subscribe(GameEventType::LEVEL_COMPLETED, [this](const GameEvent&) { onLevelCompleted(); });
+    bus.subscribe(GameEventType::ENEMY_DAMAGED, [this](const GameEvent& event) { onEnemyDamaged(event.health); });
+    bus.subscribe(GameEventType::PLAYER_DAMAGED, [this](const GameEvent& event) { onPlayerDamaged(event.health); });
+    
+    // HUD: contador de enemigos (spawns y muertes) y el resto de textos se rehacen solo tras un evento
+    for (int i = 0; i < GAME_EVENT_TYPE_COUNT; i++) {
+        bus.subscribe(static_cast<GameEventType>(i), [this](const GameEvent&) { hudDirty = true; });
     }
+}
+
+void CGame::onLevelCompleted() {
+    // Si el jugador murio en el mismo frame, manda el game over
+    if (gameState != GameState::PLAYING || !player || !player->isAlive() || !getActiveLevel()) return;
     
-    // Verificar si el nivel se completo
-    if (getActiveLevel()->isCompleted()) {
-        gameState = GameState::LEVEL_COMPLETED;
-        totalScore += 1000; // Bonus por completar nivel
+    getActiveLevel()->printTelemetry();
+    setGameState(GameState::LEVEL_COMPLETED);
+    totalScore += 1000; // Bonus por completar nivel
+}
+
+void CGame::onEnemyDamaged(int health) {
+    // Solo el ataque del jugador hiere a los enemigos
+    totalScore += 10; // Puntos por atacar
+    
+    if (health <= 0) {
+        totalScore += 50; // Bonus por eliminar enemigo
+    }
+}
+
+void CGame::onPlayerDamaged(int health) {
+    if (health <= 0 && gameState == GameState::PLAYING) {
+        setGameState(GameState::GAME_OVER);
     }
 }
 
@@ -565,10 +905,21 @@ void CGame::loadLevel(int levelIndex) {
     // Verificar que el nivel existe
     if (!levels[levelIndex]) {
         std::cerr << "Error: Nivel " << levelIndex << " es nulo" << std::endl;
-        gameState = GameState::GAME_OVER;
+        setGameState(GameState::GAME_OVER);
         return;
     }
     
+    // Nivel precargado en segundo plano: solo se entrega el layout (get() espera si aun no termino)
+    if (pendingLayout.valid() && pendingLevelIndex == levelIndex) {
+        pendingLevelIndex = -1;
+        try {
+            levels[levelIndex]->setPreparedLayout(pendingLayout.get());
+        } catch (const std::exception& e) {
+            // El nivel construira su layout en este hilo
+            std::cerr << "Aviso: fallo la precarga del nivel " << (levelIndex + 1) << ": " << e.what() << std::endl;
+        }
+    }
+    
     // Configurar fisicas del nivel ANTES de cargar
     if (physics) {
         levels[levelIndex]->initializePhysics(physics.get());
@@ -582,9 +933,10 @@ void CGame::loadLevel(int levelIndex) {
         
     } catch (const std::exception& e) {
         std::cerr << "Error al cargar nivel: " << e.what() << std::endl;
-        gameState = GameState::GAME_OVER;
+        setGameState(GameState::GAME_OVER);
         return;
     }
+    hudDirty = true;
     
     // Reposicionar jugador para este nivel especificamente
     if (player) {
@@ -598,6 +950,46 @@ void CGame::loadLevel(int levelIndex) {
         if (physics && player->getPhysicsBody()) {
             player->updatePhysicsPosition();
         }
+        
+        // Cargar ya los chunks de la posicion inicial (antes del primer paso de fisicas)
+        levels[levelIndex]->streamAround(player->getPosition(), 0.0f);
+    }
+    
+    // La camara empieza ya sobre el jugador, sin recorrer el nivel
+    camera.setBounds(levels[levelIndex]->getBoundaries());
+    if (player) {
+        sf::FloatRect bounds = player->getBounds();
+        camera.snapTo(sf::Vector2f(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f));
+    }
+    
+    // Mientras se juega este nivel, preparar el siguiente
+    preloadLevel(levelIndex + 1);
+}
+
+void CGame::preloadLevel(int levelIndex) {
+    if (levelIndex < 0 || levelIndex >= static_cast<int>(levels.size()) || !levels[levelIndex]) {
+        return;
+    }
+    
+    // Ya construido (se reutiliza en cada recarga) o ya en camino
+    if (levels[levelIndex]->hasLayout()) return;
+    if (pendingLayout.valid() && pendingLevelIndex == levelIndex) return;
+    
+    // Solo una precarga a la vez: una anterior sin recoger se descarta
+    if (pendingLayout.valid()) {
+        pendingLayout.wait();
+    }
+    
+    // Las texturas residentes se consultan aqui: el cache no se toca desde el otro hilo
+    try {
+        pendingLayout = std::async(std::launch::async, &CLevel::prepareLayout,
+                                   levels[levelIndex]->getLevelNumber(), CLevel::getResidentTextures(),
+                                   CTextureCache::getInstance().isLoadingEnabled());
+        pendingLevelIndex = levelIndex;
+    } catch (const std::exception& e) {
+        // Sin hilo disponible el nivel se construira al cargarlo, como antes
+        std::cerr << "Aviso: no se pudo precargar el nivel " << (levelIndex + 1) << ": " << e.what() << std::endl;
+        pendingLevelIndex = -1;
     }
 }
 
@@ -626,6 +1018,11 @@ const CLevel* CGame::getActiveLevel() const {
 void CGame::createPlayer() {
     std::string playerName = "Heroe"; // Nombre por defecto para evitar bloqueo de UI
     
+    // El cuerpo del jugador anterior no debe quedarse en el mundo
+    if (player && physics) {
+        physics->destroyBody(player->getPhysicsHandle());
+    }
+    
     player = std::make_unique<CPlayer>(playerName);
     
     float startX = 400.0f;  // Centro de pantalla
@@ -651,64 +1048,58 @@ void CGame::createPlayer() {
 void CGame::handleMusicInput() {
     if (!musica) return;
     
-    if (isKeyJustPressed(sf::Keyboard::M)) {
+    if (isActionJustPressed(InputAction::MUSIC_MUTE)) {
         musica->toggleSilencio();
     }
     
-    if (isKeyJustPressed(sf::Keyboard::Equal)) { 
+    if (isActionJustPressed(InputAction::VOLUME_UP)) { 
         float currentVolume = musica->getMasterVolumen();
         musica->setMasterVolumen(currentVolume + 10.0f);
     }
     
-    if (isKeyJustPressed(sf::Keyboard::Hyphen)) { 
+    if (isActionJustPressed(InputAction::VOLUME_DOWN)) { 
         float currentVolume = musica->getMasterVolumen();
         musica->setMasterVolumen(currentVolume - 10.0f);
     }
     
     // F9 = Debug de musica
-    if (isKeyJustPressed(sf::Keyboard::F9)) {
+    if (isActionJustPressed(InputAction::MUSIC_INFO)) {
         printMusicInfo();
     }
 }
 
-void CGame::handleMusicStateChanges() {
+void CGame::handleMusicStateChanges(GameState state) {
     if (!musica) return;
     
-    static GameState lastState = GameState::MENU; // Para detectar cambios
-    
-    if (gameState != lastState) {
-        switch (gameState) {
-            case GameState::MENU:
-            case GameState::GAME_OVER:
-            case GameState::VICTORY:
-                if (musica->getCurrentMusicType() != MusicType::MENU) {
-                    musica->fadeToMenuMusic(1.5f);
-                }
-                break;
-                
-            case GameState::PLAYING:
-                // Cambiar a musica del gameplay
-                if (musica->getCurrentMusicType() != MusicType::GAMEPLAY) {
-                    musica->fadeToGameplayMusic(1.5f);
-                }
-                break;
-                
-            case GameState::PAUSED:
-                // Pausar musica actual
-                musica->pauseMusic();
-                break;
-                
-            case GameState::LEVEL_COMPLETED:
-                // Mantener musica del gameplay pero bajar volumen
-                // (opcional - puedes quitar esto si no lo quieres)
-                break;
-        }
-        
-        lastState = gameState;
+    switch (state) {
+        case GameState::MENU:
+        case GameState::GAME_OVER:
+        case GameState::VICTORY:
+            if (musica->getCurrentMusicType() != MusicType::MENU) {
+                musica->fadeToMenuMusic(1.5f);
+            }
+            break;
+            
+        case GameState::PLAYING:
+            // Cambiar a musica del gameplay
+            if (musica->getCurrentMusicType() != MusicType::GAMEPLAY) {
+                musica->fadeToGameplayMusic(1.5f);
+            }
+            break;
+            
+        case GameState::PAUSED:
+            // Pausar musica actual
+            musica->pauseMusic();
+            break;
+            
+        case GameState::LEVEL_COMPLETED:
+            // Mantener musica del gameplay pero bajar volumen
+            // (opcional - puedes quitar esto si no lo quieres)
+            break;
     }
     
     // Si se reanuda desde pausa
-    if (gameState == GameState::PLAYING && musica->isPaused()) {
+    if (state == GameState::PLAYING && musica->isPaused()) {
         musica->resumeMusic();
     }
 }
@@ -719,12 +1110,12 @@ void CGame::handlePlayerMovement(float deltaTime) {
     float moveDirection = 0.0f;
     bool isMoving = false;
     
-    // Detectar teclas A/D
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
+    // Izquierda/derecha (A/D por defecto)
+    if (isActionDown(InputAction::MOVE_LEFT)) {
         moveDirection = -1.0f;
         isMoving = true;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
+    if (isActionDown(InputAction::MOVE_RIGHT)) {
         moveDirection = 1.0f;
         isMoving = true;
     }
@@ -734,7 +1125,7 @@ void CGame::handlePlayerMovement(float deltaTime) {
         if (physics && player->getPhysicsBody()) {
             // Usar fisicas
             float forceX = moveDirection * 15.0f;
-            physics->applyForce(player.get(), forceX, 0.0f);
+            physics->applyForce(player->getPhysicsHandle(), forceX, 0.0f);
             
             // Limitar velocidad maxima
             b2Body* body = player->getPhysicsBody();
@@ -774,13 +1165,13 @@ void CGame::debugMovement() {
     std::cout << "\n DEBUG DE MOVIMIENTO" << std::endl;
     std::cout << "======================" << std::endl;
     
-    // Test de teclas
-    bool keyA = sf::Keyboard::isKeyPressed(sf::Keyboard::A);
-    bool keyD = sf::Keyboard::isKeyPressed(sf::Keyboard::D);
+    // Test de acciones
+    bool moveLeft = isActionDown(InputAction::MOVE_LEFT);
+    bool moveRight = isActionDown(InputAction::MOVE_RIGHT);
     
-    std::cout << "TECLAS:" << std::endl;
-    std::cout << "   A (izquierda): " << (keyA ? "Si" : "NO") << std::endl;
-    std::cout << "   D (derecha): " << (keyD ? "Si" : "NO") << std::endl;
+    std::cout << "ACCIONES:" << std::endl;
+    std::cout << "   Izquierda: " << (moveLeft ? "Si" : "NO") << std::endl;
+    std::cout << "   Derecha: " << (moveRight ? "Si" : "NO") << std::endl;
     
     // Estado del jugador
     if (player && player->getPhysicsBody()) {
@@ -796,28 +1187,32 @@ void CGame::debugMovement() {
     std::cout << "======================\n" << std::endl;
 }
 
-void CGame::handlePlayerJump() {
+bool CGame::handlePlayerJump() {
     if (!player) {
         std::cerr << "Warning: Intento de salto sin jugador" << std::endl;
-        return;
+        return false;
     }
     
     if (!physics) {
         std::cerr << "Warning: Intento de salto sin sistema de fisicas" << std::endl;
-        return;
+        return false;
     }
     
     if (!player->getPhysicsBody()) {
         std::cerr << "Warning: Jugador sin cuerpo fisico" << std::endl;
-        return;
+        return false;
     }
     
     bool isGrounded = player->isGrounded();
     bool isAlive = player->isAlive();
     
-    if (isGrounded && isAlive) {
-        player->jump();
+    // Herido no salta (CPlayer::jump); el salto sigue en el buffer
+    if (!isGrounded || !isAlive || player->isHurt()) {
+        return false;
     }
+    
+    player->jump();
+    return true;
 }
 
 void CGame::handlePlayerAttack() {
@@ -830,12 +1225,8 @@ void CGame::handlePlayerAttack() {
         player->getPosition(), attackRange);
     
     if (targetEnemy) {
+        // La puntuacion llega con el evento ENEMY_DAMAGED (onEnemyDamaged)
         targetEnemy->takeDamage(attackDamage);
-        totalScore += 10; // Puntos por atacar
-        
-        if (!targetEnemy->isAlive()) {
-            totalScore += 50; // Bonus por eliminar enemigo
-        }
     }
 }
 
@@ -906,7 +1297,7 @@ void CGame::addEnemyToPhysics(CEnemy* enemy) {
 
 void CGame::removeEnemyFromPhysics(CEnemy* enemy) {
     if (enemy && physics) {
-        physics->destroyBody(enemy);
+        enemy->releasePhysics();
     }
 }
 
@@ -927,6 +1318,7 @@ void CGame::setupUI() {
         levelText.setFont(font);
         healthText.setFont(font);
         scoreText.setFont(font);
+        enemyText.setFont(font);
     }
     
     // Configurar barra de salud
@@ -942,6 +1334,12 @@ void CGame::setupUI() {
 }
 
 void CGame::updateUI() {
+    PROFILE_ZONE(ProfileZone::UPDATE_UI);
+    
+    // Los textos solo cambian con eventos (golpes, spawns, muertes, cambios de estado o de nivel)
+    if (!hudDirty) return;
+    hudDirty = false;
+    
     updateHealthBar();
     
     // Actualizar textos con informacion actual
@@ -952,11 +1350,15 @@ void CGame::updateUI() {
         healthText.setString("Salud: " + std::to_string(player->getHealth()) + 
                               "/" + std::to_string(player->getMaxHealth()));
     }
+    
+    if (getActiveLevel()) {
+        enemyText.setString("Enemigos: " + std::to_string(getActiveLevel()->getEnemiesAlive()));
+    }
 }
 
 void CGame::renderMenu() {
     // RENDERIZAR IMAGEN DE FONDO PRIMERO
-    if (titleScreenTexture.getSize().x > 0) {
+    if (titleScreenTexture && titleScreenTexture->getSize().x > 0) {
         window.draw(titleScreenSprite);
     } 
     
@@ -980,9 +1382,15 @@ void CGame::renderMenu() {
 }
 
 void CGame::renderGame() {
+    // Nivel y jugador en coordenadas del mundo: el nivel solo dibuja lo que cae en la vista
+    window.setView(camera.getView());
+    
     // Renderizar nivel actual
     if (getActiveLevel()) {
         getActiveLevel()->render(window);
+        
+        const SpriteBatchStats& batchStats = getActiveLevel()->getRenderStats();
+        CProfiler::getInstance().setDrawStats(batchStats.drawCalls, batchStats.vertices);
     }
     
     // Renderizar jugador
@@ -990,7 +1398,8 @@ void CGame::renderGame() {
         player->render(window);
     }
     
-    // Renderizar HUD
+    // Renderizar HUD (coordenadas de pantalla)
+    window.setView(window.getDefaultView());
     renderHUD();
 }
 
@@ -1102,9 +1511,6 @@ void CGame::renderHUD() {
     
     // Informacion del nivel actual
     if (getActiveLevel()) {
-        sf::Text enemyText;
-        if (fontLoaded) enemyText.setFont(font);
-        enemyText.setString("Enemigos: " + std::to_string(getActiveLevel()->getEnemiesAlive()));
         enemyText.setPosition(10.0f, 80.0f);
         enemyText.setCharacterSize(16);
         enemyText.setFillColor(sf::Color::Cyan);
@@ -1174,6 +1580,9 @@ void CGame::debugFullPhysicsState() {
         physics->debugPrint();
     }
     
+    // Estado del cache de texturas
+    CTextureCache::getInstance().printStats();
+    
     std::cout << "================================\n" << std::endl;
 }
 
@@ -1244,13 +1653,30 @@ void CGame::initializeWindow() {
 }
 
 void CGame::loadResources() {
+    // EMPAQUETAR HOJAS DE SPRITES EN EL ATLAS (jugador, enemigos y suelo)
+    // Debe ir antes de crear jugador y niveles: resuelven sus tablas de frames al cargar texturas
+    CTextureAtlas& atlas = CTextureAtlas::getInstance();
+    CPlayer::registerAtlasSheets();
+    CEnemyPool::registerAtlasSheets();
+    CLevel::registerAtlasSheets();
+    if (atlas.build()) {
+        atlas.printStats();
+        if (!atlasDumpPrefix.empty()) {
+            atlas.savePages(atlasDumpPrefix);
+            atlas.writeFrameTable(atlasDumpPrefix + "frames.txt");
+        }
+    } else {
+        std::cerr << "Aviso: Atlas de texturas no disponible, se usan las hojas sueltas" << std::endl;
+    }
+    
     // CARGAR IMAGEN DE TITULO
-    if (titleScreenTexture.loadFromFile("assets/title_screen.png")) {
+    titleScreenTexture = CTextureCache::getInstance().acquire("assets/title_screen.png");
+    if (titleScreenTexture) {
         // Configurar sprite de titulo
-        titleScreenSprite.setTexture(titleScreenTexture);
+        titleScreenSprite.setTexture(*titleScreenTexture);
         
         // ESCALAR IMAGEN PARA AJUSTARSE A LA VENTANA (800x600)
-        sf::Vector2u textureSize = titleScreenTexture.getSize();
+        sf::Vector2u textureSize = titleScreenTexture->getSize();
         
         // Calcular escalado para ajustar a 800x600 manteniendo aspecto
         float scaleX = 800.0f / textureSize.x;
@@ -1265,9 +1691,6 @@ void CGame::loadResources() {
         float centerX = (800.0f - spriteBounds.width) / 2.0f;
         float centerY = (600.0f - spriteBounds.height) / 2.0f;
         titleScreenSprite.setPosition(centerX, centerY);
-        
-    } else {
-        std::cerr << "Error: No se pudo cargar assets/title_screen.png" << std::endl;
     }
 }
 
@@ -1277,6 +1700,38 @@ void CGame::setupGameSettings() {
     jumpForce = 18.0f;
     attackRange = 50.0f;
     attackDamage = 25;
+    physicsStepRate = 60.0f;
+    physicsMaxSubSteps = 5;
+}
+
+void CGame::printHeadlessSummary(float wallSeconds) const {
+    float simulatedSeconds = physics ? currentTick * physics->getFixedTimeStep() : currentTick / 60.0f;
+    
+    std::cout << "=== Simulacion headless ===" << std::endl;
+    std::cout << "Ticks: " << currentTick << std::endl;
+    std::cout << "Tiempo simulado: " << simulatedSeconds << "s" << std::endl;
+    std::cout << "Tiempo real: " << wallSeconds << "s" << std::endl;
+    
+    if (wallSeconds > 0.0f) {
+        std::cout << "Ticks por segundo: " << (currentTick / wallSeconds) << std::endl;
+        std::cout << "Velocidad: x" << (simulatedSeconds / wallSeconds) << " tiempo real" << std::endl;
+    }
+    
+    std::cout << "Estado final: " << gameStateToString(gameState) << std::endl;
+    std::cout << "Nivel: " << getCurrentLevel() << " | Puntuacion: " << totalScore << std::endl;
+    
+    if (player) {
+        sf::Vector2f pos = player->getPosition();
+        std::cout << "Jugador: (" << pos.x << ", " << pos.y << ") Salud: " 
+                  << player->getHealth() << "/" << player->getMaxHealth() << std::endl;
+    }
+    
+    if (getActiveLevel()) {
+        std::cout << "Enemigos vivos: " << getActiveLevel()->getEnemiesAlive() 
+                  << " | Eliminados: " << getActiveLevel()->getEnemiesKilled() << std::endl;
+    }
+    
+    std::cout << "===========================" << std::endl;
 }
 
 // DEBUG
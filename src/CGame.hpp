@@ -5,11 +5,17 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <future>
 #include "CPlayer.hpp"
 #include "CLevel.hpp"
 #include "CEnemy.hpp"
 #include "CPhysics.hpp"  // ← Sistema de físicas Box2D
 #include "CMusica.hpp"   // ← NUEVO: Sistema de música
+#include "CInputScript.hpp"
+#include "CInput.hpp"
+#include "CReplay.hpp"
+#include "CCamera.hpp"
+#include "CEventBus.hpp"
 
 enum class GameState {
     MENU,
@@ -26,17 +32,40 @@ private:
     sf::RenderWindow window;
     sf::Clock clock;
     sf::Font font;
+    CCamera camera;                              // Vista del nivel (HUD y menús usan la vista por defecto)
     
     // Game State
     GameState gameState;
     bool running;
     bool fontLoaded;
     
+    // ===================================
+    // Modo headless (sin ventana, texturas ni audio)
+    // ===================================
+    bool headless;
+    CInputScript* inputScript;                // Entrada programada (solo headless)
+    long currentTick;                         // Ticks de simulación ejecutados
+    
+    // ===================================
+    // Grabación / reproducción determinista
+    // ===================================
+    uint32_t randomSeed;                      // Semilla de CRandom::getGlobal() para la sesión
+    std::unique_ptr<CReplay> recording;       // Entrada que se está grabando (opcional)
+    std::string recordingPath;
+    std::unique_ptr<CReplay> replay;          // Entrada que se está reproduciendo (opcional)
+    bool replayDiverged;
+    float tickAccumulator;                    // Tiempo real pendiente de simular en modo lockstep
+    std::string atlasDumpPrefix;              // Si no está vacío: volcar el atlas al construirlo
+    
     // Game Objects
     std::unique_ptr<CPlayer> player;
     std::vector<std::unique_ptr<CLevel>> levels;
     int currentLevelIndex;
     
+    // Precarga del siguiente nivel en un hilo aparte (layout + imágenes decodificadas)
+    std::future<std::unique_ptr<LevelLayout>> pendingLayout;
+    int pendingLevelIndex;
+    
     // ===================================
     // Sistema de físicas Box2D
     // ===================================
@@ -48,7 +77,7 @@ private:
     std::unique_ptr<CMusica> musica;
     
     // Input handling
-    bool keyPressed[sf::Keyboard::KeyCount];
+    CInput input;                             // Acciones del tick (teclado, script o replay)
     float inputCooldown;
     
     // Game settings
@@ -56,6 +85,8 @@ private:
     float jumpForce;        // Fuerza de salto del jugador
     float attackRange;
     int attackDamage;
+    float physicsStepRate;  // Pasos fijos de físicas por segundo
+    int physicsMaxSubSteps; // Máximo de pasos de físicas por frame
     
     // UI Elements
     sf::Text titleText;
@@ -64,7 +95,9 @@ private:
     sf::Text levelText;
     sf::Text healthText;
     sf::Text scoreText;
-    sf::Texture titleScreenTexture;           // ← NUEVA: Textura de la pantalla de título
+    sf::Text enemyText;
+    bool hudDirty;                            // Algún evento cambió lo que muestra el HUD
+    TextureHandle titleScreenTexture;         // ← NUEVA: Textura de la pantalla de título
     sf::Sprite titleScreenSprite;             // ← NUEVA: Sprite de la pantalla de título
 
     // Game statistics
@@ -84,6 +117,20 @@ public:
     // Main game loop
     void run();
     
+    // Simulación headless: avanza maxTicks ticks fijos con entrada programada, sin esperar al reloj
+    void runHeadless(CInputScript& script, long maxTicks);
+    bool isHeadless() const;
+    
+    // Grabación y reproducción (llamar antes de run()/runHeadless())
+    void setRandomSeed(uint32_t seed);
+    void startRecording(const std::string& path);
+    bool loadReplay(const std::string& path);
+    long getReplayLength() const;
+    bool hasReplayDiverged() const;
+    
+    // Atlas de texturas: escribir <prefijo>N.png y <prefijo>frames.txt tras construirlo
+    void setAtlasDumpPrefix(const std::string& prefix);
+    
     // Game state management
     void initialize();
     void cleanup();
@@ -119,19 +166,38 @@ private:
     void processMenuInput();
     void processGameInput(float deltaTime);
     void processPauseInput();
-    bool isKeyJustPressed(sf::Keyboard::Key key);
+    bool isActionJustPressed(InputAction action) const;  // Pulsada en este tick y sin cooldown
+    bool isActionDown(InputAction action) const;
+    void handleEscapeKey();
+    
+    // Ticks fijos (headless, grabación y reproducción)
+    bool isLockstep() const;
+    void runLockstepTicks(float deltaTime);
+    void simulateTick();
+    void sampleInput(float deltaTime);
+    void updateReplayCheckpoints();
+    void finishSession();
+    uint64_t computeStateHash() const;
     
     // Game logic
     void updateGameplay(float deltaTime);
     void updatePhysics(float deltaTime);          // Actualizar sistema de físicas
+    void updateCamera(float deltaTime);           // Seguir al jugador tras el paso de físicas
     void updateMusic(float deltaTime);            // ← NUEVO: Actualizar sistema de música
     void checkCollisions();
     void checkPlayerEnemyCollisions();
     void checkAttackCollisions();
-    void updateGameState();
+    void setGameState(GameState state);           // Publica STATE_CHANGED si cambia
+    
+    // Suscriptores del bus de eventos (ver CEventBus)
+    void subscribeToEvents();
+    void onLevelCompleted();
+    void onEnemyDamaged(int health);
+    void onPlayerDamaged(int health);
     
     // Level management
     void loadLevel(int levelIndex);
+    void preloadLevel(int levelIndex);            // Preparar un nivel en segundo plano
     void createLevels();
     CLevel* getActiveLevel();                     // Devuelve puntero al nivel activo
     const CLevel* getActiveLevel() const;         // Versión const del método anterior
@@ -139,7 +205,7 @@ private:
     // Player management
     void createPlayer();
     void handlePlayerMovement(float deltaTime);
-    void handlePlayerJump();                      // Manejar salto del jugador
+    bool handlePlayerJump();                      // Manejar salto del jugador (false si no puede saltar)
     void handlePlayerAttack();
     void updatePlayerBounds();
     void syncPlayerWithPhysics();                 // Sincronizar posición física con visual
@@ -158,7 +224,7 @@ private:
     // NUEVO: Music management
     // ===================================
     void initializeMusic();                       // Inicializar sistema de música
-    void handleMusicStateChanges();               // Manejar cambios de música según el estado del juego
+    void handleMusicStateChanges(GameState state);  // Música del nuevo estado (desde onGameStateChanged)
     void handleMusicInput();                      // Controles de música (silenciar, volumen, etc.)
     
     // UI and rendering
@@ -187,6 +253,7 @@ private:
     void initializeWindow();
     void loadResources();
     void setupGameSettings();
+    void printHeadlessSummary(float wallSeconds) const;
     
     // Debug methods
     void printGameState() const;
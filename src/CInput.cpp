@@ -0,0 +1,235 @@
+#include "CInput.hpp"
+#include "CInputScript.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    // Nombres de las acciones en assets/controls.txt (mismo orden que InputAction)
+    const char* const ACTION_NAMES[INPUT_ACTION_COUNT] = {
+        "izquierda",
+        "derecha",
+        "saltar",
+        "atacar",
+        "aceptar",
+        "pausa",
+        "reiniciar",
+        "silenciar",
+        "subir_volumen",
+        "bajar_volumen",
+        "info_musica",
+        "debug_posiciones",
+        "debug_fisicas",
+        "debug_plataformas",
+        "plataforma_arriba",
+        "plataforma_abajo",
+        "plataforma_izquierda",
+        "plataforma_derecha",
+        "plataforma_reset",
+        "plataforma_gruesa",
+        "plataforma_fina",
+        "info_plataformas",
+        "reposicionar_jugador"
+    };
+
+    // Acciones que se recuerdan durante BUFFER_TIME
+    const InputMask BUFFERED_ACTIONS = CInput::bit(InputAction::JUMP) | CInput::bit(InputAction::ATTACK);
+}
+
+// Constructor
+CInput::CInput()
+    : liveTapped(0), current(0), previous(0) {
+    bufferTimers.fill(0.0f);
+    resetBindings();
+}
+
+const char* CInput::getActionName(InputAction action) {
+    int index = static_cast<int>(action);
+    if (index < 0 || index >= INPUT_ACTION_COUNT) {
+        return "desconocida";
+    }
+    return ACTION_NAMES[index];
+}
+
+InputAction CInput::actionFromName(const std::string& name) {
+    for (int i = 0; i < INPUT_ACTION_COUNT; i++) {
+        if (name == ACTION_NAMES[i]) {
+            return static_cast<InputAction>(i);
+        }
+    }
+    return InputAction::COUNT;
+}
+
+// ASIGNACION DE TECLAS
+void CInput::resetBindings() {
+    keyActions.fill(0);
+
+    bind(InputAction::MOVE_LEFT, sf::Keyboard::A);
+    bind(InputAction::MOVE_RIGHT, sf::Keyboard::D);
+    bind(InputAction::JUMP, sf::Keyboard::W);
+    bind(InputAction::JUMP, sf::Keyboard::Space);
+    bind(InputAction::ATTACK, sf::Keyboard::Enter);
+    bind(InputAction::CONFIRM, sf::Keyboard::Enter);
+    bind(InputAction::CONFIRM, sf::Keyboard::Space);
+    bind(InputAction::PAUSE, sf::Keyboard::Escape);
+    bind(InputAction::RESTART, sf::Keyboard::R);
+    bind(InputAction::MUSIC_MUTE, sf::Keyboard::M);
+    bind(InputAction::VOLUME_UP, sf::Keyboard::Equal);
+    bind(InputAction::VOLUME_DOWN, sf::Keyboard::Hyphen);
+    bind(InputAction::MUSIC_INFO, sf::Keyboard::F9);
+    bind(InputAction::DEBUG_POSITIONS, sf::Keyboard::I);
+    bind(InputAction::DEBUG_PHYSICS, sf::Keyboard::P);
+    bind(InputAction::DEBUG_PLATFORMS, sf::Keyboard::F1);
+    bind(InputAction::PLATFORM_UP, sf::Keyboard::F2);
+    bind(InputAction::PLATFORM_DOWN, sf::Keyboard::F3);
+    bind(InputAction::PLATFORM_LEFT, sf::Keyboard::F4);
+    bind(InputAction::PLATFORM_RIGHT, sf::Keyboard::F5);
+    bind(InputAction::PLATFORM_RESET, sf::Keyboard::F6);
+    bind(InputAction::PLATFORM_THICKER, sf::Keyboard::F7);
+    bind(InputAction::PLATFORM_THINNER, sf::Keyboard::F8);
+    bind(InputAction::PLATFORM_INFO, sf::Keyboard::T);
+    bind(InputAction::REPOSITION_PLAYER, sf::Keyboard::Y);
+}
+
+void CInput::bind(InputAction action, sf::Keyboard::Key key) {
+    if (!isValidKey(key) || action == InputAction::COUNT) return;
+    keyActions[key] |= bit(action);
+}
+
+void CInput::unbind(InputAction action, sf::Keyboard::Key key) {
+    if (!isValidKey(key)) return;
+    keyActions[key] &= ~bit(action);
+}
+
+void CInput::clearBindings(InputAction action) {
+    for (InputMask& actions : keyActions) {
+        actions &= ~bit(action);
+    }
+}
+
+InputMask CInput::getKeyActions(sf::Keyboard::Key key) const {
+    return isValidKey(key) ? keyActions[key] : 0;
+}
+
+bool CInput::loadBindings(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+
+        // Ignorar comentarios y lineas vacias
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line = line.substr(0, comment);
+        }
+
+        std::istringstream stream(line);
+        std::string actionName;
+        if (!(stream >> actionName)) {
+            continue;
+        }
+
+        InputAction action = actionFromName(actionName);
+        if (action == InputAction::COUNT) {
+            std::cerr << "CInput: Accion desconocida '" << actionName
+                      << "' en la linea " << lineNumber << " de " << path << std::endl;
+            continue;
+        }
+
+        // La linea sustituye las teclas por defecto de la accion
+        clearBindings(action);
+        std::string keyName;
+        while (stream >> keyName) {
+            sf::Keyboard::Key key = CInputScript::keyFromName(keyName);
+            if (key == sf::Keyboard::Unknown) {
+                std::cerr << "CInput: Tecla desconocida '" << keyName
+                          << "' en la linea " << lineNumber << " de " << path << std::endl;
+                continue;
+            }
+            bind(action, key);
+        }
+    }
+
+    std::cout << "CInput: Controles cargados de " << path << std::endl;
+    return true;
+}
+
+// TECLADO REAL
+void CInput::handleEvent(const sf::Event& event) {
+    if (event.type == sf::Event::KeyPressed) {
+        sf::Keyboard::Key key = event.key.code;
+        if (!isValidKey(key) || keysDown[key]) return;  // Autorepetición del sistema
+
+        keysDown[key] = true;
+        liveTapped |= keyActions[key];
+    }
+    else if (event.type == sf::Event::KeyReleased) {
+        sf::Keyboard::Key key = event.key.code;
+        if (isValidKey(key)) {
+            keysDown[key] = false;
+        }
+    }
+    else if (event.type == sf::Event::LostFocus) {
+        releaseAll();
+    }
+}
+
+void CInput::releaseAll() {
+    keysDown.reset();
+    liveTapped = 0;
+}
+
+InputMask CInput::takeLiveMask() {
+    // Una pulsación que empieza y acaba entre dos ticks cuenta en el siguiente
+    InputMask mask = getHeldMask() | liveTapped;
+    liveTapped = 0;
+    return mask;
+}
+
+// OTRAS FUENTES
+InputMask CInput::getScriptMask(const CInputScript& script) const {
+    InputMask mask = 0;
+    for (int key = 0; key < sf::Keyboard::KeyCount; key++) {
+        if (keyActions[key] != 0 && script.isKeyDown(static_cast<sf::Keyboard::Key>(key))) {
+            mask |= keyActions[key];
+        }
+    }
+    return mask;
+}
+
+// TICK
+void CInput::advance(InputMask mask, float deltaTime) {
+    previous = current;
+    current = mask;
+
+    InputMask pressed = current & ~previous;
+    for (int i = 0; i < INPUT_ACTION_COUNT; i++) {
+        InputMask actionBit = InputMask(1) << i;
+        if (!(BUFFERED_ACTIONS & actionBit)) continue;
+
+        if (pressed & actionBit) {
+            bufferTimers[i] = BUFFER_TIME;
+        }
+        else if (bufferTimers[i] > 0.0f) {
+            bufferTimers[i] -= deltaTime;
+        }
+    }
+}
+
+// PRIVADOS
+InputMask CInput::getHeldMask() const {
+    if (keysDown.none()) return 0;
+
+    InputMask mask = 0;
+    for (int key = 0; key < sf::Keyboard::KeyCount; key++) {
+        if (keysDown[key]) {
+            mask |= keyActions[key];
+        }
+    }
+    return mask;
+}
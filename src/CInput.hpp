@@ -0,0 +1,111 @@
+#ifndef CINPUT_HPP
+#define CINPUT_HPP
+
+#include <SFML/Window.hpp>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <string>
+
+class CInputScript;
+
+// Acciones del juego; el índice de cada una es su bit en un InputMask (y en los replays):
+// añadir nuevas al final, nunca reordenar
+enum class InputAction : uint8_t {
+    MOVE_LEFT,
+    MOVE_RIGHT,
+    JUMP,
+    ATTACK,
+    CONFIRM,             // Menú y pantallas de fin de nivel/partida
+    PAUSE,
+    RESTART,
+    MUSIC_MUTE,
+    VOLUME_UP,
+    VOLUME_DOWN,
+    MUSIC_INFO,
+    DEBUG_POSITIONS,
+    DEBUG_PHYSICS,
+    DEBUG_PLATFORMS,
+    PLATFORM_UP,
+    PLATFORM_DOWN,
+    PLATFORM_LEFT,
+    PLATFORM_RIGHT,
+    PLATFORM_RESET,
+    PLATFORM_THICKER,
+    PLATFORM_THINNER,
+    PLATFORM_INFO,
+    REPOSITION_PLAYER,
+    COUNT
+};
+
+const int INPUT_ACTION_COUNT = static_cast<int>(InputAction::COUNT);
+
+// Acciones activas en un tick: bit i = InputAction i
+using InputMask = uint32_t;
+
+// ===============================================
+// Entrada del jugador por acciones
+// ===============================================
+// Las teclas llegan como eventos de la ventana (handleEvent, desde
+// CGame::handleEvents) y se traducen a acciones con una tabla tecla -> acciones
+// que se puede cambiar (bind/unbind, loadBindings). Una tecla puede activar
+// varias acciones (Enter ataca en partida y acepta en los menús).
+// Cada tick recibe un InputMask con lo que estuvo pulsado durante el tick,
+// aunque se soltara antes de muestrearlo: del teclado (takeLiveMask), de un
+// script headless (getScriptMask) o de un replay. advance() es la única
+// entrada de la simulación, así que las tres fuentes se comportan igual y un
+// replay solo necesita la máscara de cada tick. Saltar y atacar quedan en un
+// buffer durante BUFFER_TIME: si en el tick de la pulsación no se pueden hacer
+// (en el aire, herido) se hacen en cuanto se pueda.
+class CInput {
+public:
+    static constexpr float BUFFER_TIME = 0.15f;  // Segundos que se recuerda una pulsación de salto o ataque
+
+private:
+    std::array<InputMask, sf::Keyboard::KeyCount> keyActions;   // Acciones de cada tecla
+    std::bitset<sf::Keyboard::KeyCount> keysDown;               // Según los eventos recibidos
+    InputMask liveTapped;                        // Pulsadas desde el último takeLiveMask()
+
+    // Estado del tick actual
+    InputMask current;
+    InputMask previous;
+    std::array<float, INPUT_ACTION_COUNT> bufferTimers;
+
+public:
+    CInput();
+
+    static constexpr InputMask bit(InputAction action) { return InputMask(1) << static_cast<int>(action); }
+    static const char* getActionName(InputAction action);
+    static InputAction actionFromName(const std::string& name);   // COUNT si no existe
+
+    // Asignación de teclas
+    void resetBindings();
+    void bind(InputAction action, sf::Keyboard::Key key);
+    void unbind(InputAction action, sf::Keyboard::Key key);
+    void clearBindings(InputAction action);
+    InputMask getKeyActions(sf::Keyboard::Key key) const;
+    bool loadBindings(const std::string& path);  // Líneas "<accion> <tecla> [tecla...]"; false si no se abre
+
+    // Teclado real (eventos de la ventana)
+    void handleEvent(const sf::Event& event);
+    void releaseAll();                           // Al perder el foco no llegan los KeyReleased
+    InputMask takeLiveMask();                    // Pulsadas ahora o desde la llamada anterior
+
+    // Otras fuentes de entrada
+    InputMask getScriptMask(const CInputScript& script) const;
+
+    // Tick
+    void advance(InputMask mask, float deltaTime);
+    InputMask getMask() const { return current; }
+    bool isDown(InputAction action) const { return (current & bit(action)) != 0; }
+    bool wasPressed(InputAction action) const { return (current & ~previous & bit(action)) != 0; }
+    bool isBuffered(InputAction action) const { return bufferTimers[static_cast<int>(action)] > 0.0f; }
+    void consume(InputAction action) { bufferTimers[static_cast<int>(action)] = 0.0f; }
+    void clearBuffers() { bufferTimers.fill(0.0f); }
+
+private:
+    static bool isValidKey(sf::Keyboard::Key key) { return key >= 0 && key < sf::Keyboard::KeyCount; }
+    InputMask getHeldMask() const;
+};
+
+#endif // CINPUT_HPP
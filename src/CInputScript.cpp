@@ -0,0 +1,170 @@
+#include "CInputScript.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+namespace {
+    // Teclas con nombre para los scripts y para reasignar controles (ver CInput)
+    struct KeyName {
+        const char* name;
+        sf::Keyboard::Key key;
+    };
+
+    const KeyName KEY_NAMES[] = {
+        {"A", sf::Keyboard::A},
+        {"D", sf::Keyboard::D},
+        {"W", sf::Keyboard::W},
+        {"I", sf::Keyboard::I},
+        {"M", sf::Keyboard::M},
+        {"P", sf::Keyboard::P},
+        {"R", sf::Keyboard::R},
+        {"T", sf::Keyboard::T},
+        {"Y", sf::Keyboard::Y},
+        {"Space", sf::Keyboard::Space},
+        {"Enter", sf::Keyboard::Enter},
+        {"Escape", sf::Keyboard::Escape},
+        {"Equal", sf::Keyboard::Equal},
+        {"Hyphen", sf::Keyboard::Hyphen},
+        {"F1", sf::Keyboard::F1},
+        {"F2", sf::Keyboard::F2},
+        {"F3", sf::Keyboard::F3},
+        {"F4", sf::Keyboard::F4},
+        {"F5", sf::Keyboard::F5},
+        {"F6", sf::Keyboard::F6},
+        {"F7", sf::Keyboard::F7},
+        {"F8", sf::Keyboard::F8},
+        {"F9", sf::Keyboard::F9},
+        {"J", sf::Keyboard::J},
+        {"K", sf::Keyboard::K},
+        {"L", sf::Keyboard::L},
+        {"S", sf::Keyboard::S},
+        {"LShift", sf::Keyboard::LShift},
+        {"LControl", sf::Keyboard::LControl},
+        {"Left", sf::Keyboard::Left},
+        {"Right", sf::Keyboard::Right},
+        {"Up", sf::Keyboard::Up},
+        {"Down", sf::Keyboard::Down}
+    };
+}
+
+// Constructor
+CInputScript::CInputScript() : nextEvent(0) {
+    for (int i = 0; i < sf::Keyboard::KeyCount; i++) {
+        keyState[i] = false;
+    }
+}
+
+// CARGA Y CONSTRUCCION
+bool CInputScript::loadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "CInputScript: No se pudo abrir " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+
+        // Ignorar comentarios y lineas vacias
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line = line.substr(0, comment);
+        }
+
+        std::istringstream stream(line);
+        long tick;
+        std::string action;
+        if (!(stream >> tick)) {
+            continue;
+        }
+
+        if (!(stream >> action) || action.size() < 2 || (action[0] != '+' && action[0] != '-')) {
+            std::cerr << "CInputScript: Linea " << lineNumber << " invalida en " << path << std::endl;
+            continue;
+        }
+
+        sf::Keyboard::Key key = keyFromName(action.substr(1));
+        if (key == sf::Keyboard::Unknown) {
+            std::cerr << "CInputScript: Tecla desconocida '" << action.substr(1)
+                      << "' en la linea " << lineNumber << std::endl;
+            continue;
+        }
+
+        events.emplace_back(tick, key, action[0] == '+');
+    }
+
+    sortEvents();
+    reset();
+
+    std::cout << "CInputScript: " << events.size() << " eventos cargados de " << path << std::endl;
+    return true;
+}
+
+void CInputScript::addEvent(long tick, sf::Keyboard::Key key, bool pressed) {
+    events.emplace_back(tick, key, pressed);
+    sortEvents();
+}
+
+void CInputScript::reset() {
+    nextEvent = 0;
+    for (int i = 0; i < sf::Keyboard::KeyCount; i++) {
+        keyState[i] = false;
+    }
+}
+
+// REPRODUCCION
+void CInputScript::advanceTo(long tick) {
+    while (nextEvent < events.size() && events[nextEvent].tick <= tick) {
+        const ScriptedKeyEvent& event = events[nextEvent];
+        if (event.key >= 0 && event.key < sf::Keyboard::KeyCount) {
+            keyState[event.key] = event.pressed;
+        }
+        nextEvent++;
+    }
+}
+
+bool CInputScript::isKeyDown(sf::Keyboard::Key key) const {
+    if (key < 0 || key >= sf::Keyboard::KeyCount) {
+        return false;
+    }
+    return keyState[key];
+}
+
+long CInputScript::getLastTick() const {
+    return events.empty() ? 0 : events.back().tick;
+}
+
+size_t CInputScript::getEventCount() const {
+    return events.size();
+}
+
+// NOMBRES DE TECLAS
+sf::Keyboard::Key CInputScript::keyFromName(const std::string& name) {
+    for (const KeyName& entry : KEY_NAMES) {
+        if (name == entry.name) {
+            return entry.key;
+        }
+    }
+    return sf::Keyboard::Unknown;
+}
+
+std::string CInputScript::keyToName(sf::Keyboard::Key key) {
+    for (const KeyName& entry : KEY_NAMES) {
+        if (key == entry.key) {
+            return entry.name;
+        }
+    }
+    return "Desconocida";
+}
+
+// METODOS PRIVADOS
+void CInputScript::sortEvents() {
+    // stable_sort: los eventos del mismo tick conservan el orden del archivo
+    std::stable_sort(events.begin(), events.end(),
+        [](const ScriptedKeyEvent& a, const ScriptedKeyEvent& b) {
+            return a.tick < b.tick;
+        });
+}
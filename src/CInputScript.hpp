@@ -0,0 +1,56 @@
+#ifndef CINPUTSCRIPT_HPP
+#define CINPUTSCRIPT_HPP
+
+#include <SFML/Window.hpp>
+#include <string>
+#include <vector>
+
+// Evento de teclado programado para un tick concreto
+struct ScriptedKeyEvent {
+    long tick;
+    sf::Keyboard::Key key;
+    bool pressed;
+
+    ScriptedKeyEvent(long t, sf::Keyboard::Key k, bool p)
+        : tick(t), key(k), pressed(p) {}
+};
+
+// ===============================================
+// Entrada programada para el modo headless
+// ===============================================
+// Formato del archivo (una linea por evento, '#' para comentarios):
+//   <tick> +<Tecla>    presionar tecla en ese tick
+//   <tick> -<Tecla>    soltar tecla en ese tick
+// Ejemplo:
+//   0 +Enter
+//   2 -Enter
+//   10 +D
+class CInputScript {
+private:
+    std::vector<ScriptedKeyEvent> events;     // Ordenados por tick
+    size_t nextEvent;                         // Próximo evento por aplicar
+    bool keyState[sf::Keyboard::KeyCount];    // Estado actual de cada tecla
+
+public:
+    CInputScript();
+
+    // Carga y construcción
+    bool loadFromFile(const std::string& path);
+    void addEvent(long tick, sf::Keyboard::Key key, bool pressed);
+    void reset();
+
+    // Reproducción
+    void advanceTo(long tick);                 // Aplicar todos los eventos con tick <= tick
+    bool isKeyDown(sf::Keyboard::Key key) const;
+    long getLastTick() const;
+    size_t getEventCount() const;
+
+    // Nombres de teclas usados en los scripts y en assets/controls.txt
+    static sf::Keyboard::Key keyFromName(const std::string& name);
+    static std::string keyToName(sf::Keyboard::Key key);
+
+private:
+    void sortEvents();
+};
+
+#endif // CINPUTSCRIPT_HPP
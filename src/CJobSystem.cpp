@@ -0,0 +1,127 @@
+#include "CJobSystem.hpp"
+#include "CTraceWriter.hpp"
+#include <algorithm>
+#include <iostream>
+
+// Constructor: un hilo por núcleo salvo el del que llama (que también trabaja)
+CJobSystem::CJobSystem() : queuedTasks(0), stopRequested(false), tasksRun(0), tasksStolen(0) {
+    unsigned int cores = std::thread::hardware_concurrency();
+    size_t workerCount = cores > 1 ? cores - 1 : 0;
+
+    for (size_t i = 0; i <= workerCount; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.emplace_back(&CJobSystem::workerLoop, this, i);
+    }
+
+    std::cout << "CJobSystem: " << workerCount << " hilos de trabajo" << std::endl;
+}
+
+CJobSystem::~CJobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopRequested = true;
+    }
+    wakeSignal.notify_all();
+
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+// PARALLEL FOR
+void CJobSystem::parallelFor(size_t count, size_t grain, const RangeFunction& function) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+
+    // Sin hilos o con un solo trozo no compensa repartir
+    if (workers.empty() || count <= grain) {
+        function(0, count);
+        return;
+    }
+
+    size_t taskCount = (count + grain - 1) / grain;
+    std::atomic<size_t> pending(taskCount);
+
+    // Reparto inicial en turno rotatorio; los desequilibrios los corrige el robo
+    for (size_t t = 0; t < taskCount; t++) {
+        size_t begin = t * grain;
+        Task task{&function, begin, std::min(begin + grain, count), &pending};
+
+        WorkQueue& queue = *queues[t % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+    }
+    {
+        // Publicar bajo el mutex: un hilo a punto de dormirse no puede perder el aviso
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedTasks.fetch_add(taskCount, std::memory_order_release);
+    }
+    wakeSignal.notify_all();
+
+    // El que llama trabaja su cola y roba hasta que no quede nada de este parallelFor
+    size_t self = queues.size() - 1;
+    while (pending.load(std::memory_order_acquire) > 0) {
+        Task task;
+        if (popLocal(self, task) || steal(self, task)) {
+            run(task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// HILOS
+void CJobSystem::workerLoop(size_t queueIndex) {
+    CTraceWriter::getInstance().setThreadName("CJobSystem worker");
+
+    while (true) {
+        Task task;
+        if (popLocal(queueIndex, task) || steal(queueIndex, task)) {
+            run(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeSignal.wait(lock, [this]() {
+            return stopRequested || queuedTasks.load(std::memory_order_acquire) > 0;
+        });
+        if (stopRequested) return;
+    }
+}
+
+bool CJobSystem::popLocal(size_t queueIndex, Task& task) {
+    WorkQueue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+
+    task = queue.tasks.front();
+    queue.tasks.pop_front();
+    queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool CJobSystem::steal(size_t thiefIndex, Task& task) {
+    // Empezar por la cola siguiente para no cargar siempre a la primera
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        WorkQueue& queue = *queues[(thiefIndex + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+        tasksStolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void CJobSystem::run(const Task& task) {
+    (*task.function)(task.begin, task.end);
+    tasksRun.fetch_add(1, std::memory_order_relaxed);
+    task.pending->fetch_sub(1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,83 @@
+#ifndef CJOBSYSTEM_HPP
+#define CJOBSYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ===============================================
+// Pool de hilos con robo de trabajo
+// ===============================================
+// parallelFor() trocea un rango en tareas y las reparte entre las colas de los
+// hilos (una por hilo, más una para el hilo que llama). Cada hilo saca de la
+// cabeza de su cola y, cuando se queda sin trabajo, roba de la cola de otro
+// por el final; así un hilo que termina pronto ayuda al que tiene trozos más
+// caros. El hilo que llama también trabaja y no vuelve hasta que se han
+// completado todas las tareas, de modo que la función puede usar datos de su
+// pila. Las tareas no deben tocar nada compartido que no sea de solo lectura
+// (o escribir en posiciones distintas de un buffer). Con un solo núcleo, o
+// rangos pequeños, todo se ejecuta en el hilo que llama.
+class CJobSystem {
+public:
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    static const size_t DEFAULT_GRAIN = 64;      // Elementos por tarea si no se indica otra cosa
+
+private:
+    struct Task {
+        const RangeFunction* function;
+        size_t begin;
+        size_t end;
+        std::atomic<size_t>* pending;            // Tareas sin terminar del parallelFor que la creó
+    };
+
+    // Cola de un hilo: el dueño saca por delante, los ladrones por detrás
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;  // [0, workers) de los hilos; la última, del que llama
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeSignal;
+    std::atomic<size_t> queuedTasks;
+    bool stopRequested;                          // Protegido por sleepMutex
+
+    std::atomic<size_t> tasksRun;
+    std::atomic<size_t> tasksStolen;
+
+    CJobSystem();
+
+public:
+    CJobSystem(const CJobSystem&) = delete;
+    CJobSystem& operator=(const CJobSystem&) = delete;
+    ~CJobSystem();
+
+    static CJobSystem& getInstance() {
+        static CJobSystem instance;
+        return instance;
+    }
+
+    // Ejecuta function sobre trozos de [0, count) de como mucho grain elementos; bloquea hasta terminar
+    void parallelFor(size_t count, size_t grain, const RangeFunction& function);
+
+    size_t getWorkerCount() const { return workers.size(); }
+    size_t getTasksRun() const { return tasksRun.load(std::memory_order_relaxed); }
+    size_t getTasksStolen() const { return tasksStolen.load(std::memory_order_relaxed); }
+
+private:
+    void workerLoop(size_t queueIndex);
+    bool popLocal(size_t queueIndex, Task& task);
+    bool steal(size_t thiefIndex, Task& task);
+    void run(const Task& task);
+};
+
+#endif // CJOBSYSTEM_HPP
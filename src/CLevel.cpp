@@ -1,7 +1,13 @@
 #include "CLevel.hpp"
 #include "CPhysics.hpp"
+#include "CReplay.hpp"
+#include "CTraceWriter.hpp"
+#include "CCamera.hpp"
+#include "CAllocationCounter.hpp"
+#include "CEventBus.hpp"
 #include <iostream>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <limits>
 
@@ -9,8 +15,10 @@
 CLevel::CLevel(int levelNumber) 
     : levelNumber(levelNumber), state(LevelState::LOADING),
       physics(nullptr),        
-      levelSize(800.0f, 600.0f), levelTime(0.0f), spawnTimer(0.0f),
-      totalEnemies(0), enemiesKilled(0), texturesLoaded(false),
+      levelSize(800.0f, 600.0f), platformGridDirty(true),
+      streamFocus(DEFAULT_FOCUS_X, DEFAULT_FOCUS_Y), streamDirection(0.0f, 0.0f), pendingChunkIndex(CChunkGrid::NO_CHUNK),
+      levelTime(0.0f), spawnTimer(0.0f),
+      totalEnemies(0), levelStats(), spawnStats{0, 0, 0, 0}, floorFrame{nullptr, sf::IntRect(0, 0, 0, 0)}, texturesLoaded(false),
       loaded(false), completionTime(0.0f) {
     
     levelName = "Nivel " + std::to_string(levelNumber);
@@ -23,6 +31,7 @@ CLevel::~CLevel() {
     destroyPhysicalPlatforms();
     destroyLevelBoundaries();
     unloadLevel();
+    clearEnemies();                               // Si no estaba cargado: los cuerpos aparcados vuelven a Box2D
 }
 
 // GETTERS
@@ -55,22 +64,34 @@ int CLevel::getTotalEnemies() const {
 }
 
 int CLevel::getEnemiesKilled() const {
-    return enemiesKilled;
+    return levelStats.totalKilled;
 }
 
 int CLevel::getEnemiesAlive() const {
-    int aliveCount = 0;
-    for (const auto& enemy : enemies) {
-        if (enemy && enemy->isAlive()) {
-            aliveCount++;
-        }
-    }
-    return aliveCount;
+    return levelStats.totalAlive;
+}
+
+size_t CLevel::getPendingSpawns() const {
+    return levelStats.pendingSpawns;
+}
+
+const LevelStats& CLevel::getLevelStats() const {
+    return levelStats;
+}
+
+LevelTelemetry CLevel::getTelemetry() const {
+    LevelTelemetry telemetry;
+    telemetry.levelNumber = levelNumber;
+    telemetry.playTime = state == LevelState::COMPLETED ? completionTime : levelTime;
+    telemetry.timeToClear = state == LevelState::COMPLETED ? completionTime : -1.0f;
+    telemetry.kills = levelStats.totalKilled;
+    telemetry.killsPerMinute = telemetry.playTime > 0.0f ? levelStats.totalKilled * 60.0f / telemetry.playTime : 0.0f;
+    return telemetry;
 }
 
 float CLevel::getCompletionPercentage() const {
     if (totalEnemies == 0) return 100.0f;
-    return (static_cast<float>(enemiesKilled) / static_cast<float>(totalEnemies)) * 100.0f;
+    return (static_cast<float>(levelStats.totalKilled) / static_cast<float>(totalEnemies)) * 100.0f;
 }
 
 bool CLevel::isLoaded() const {
@@ -96,6 +117,7 @@ void CLevel::setState(LevelState state) {
         
         if (state == LevelState::COMPLETED) {
             completionTime = levelTime;
+            CEventBus::getInstance().publish(GameEventType::LEVEL_COMPLETED, levelNumber);
         }
     }
 }
@@ -104,6 +126,7 @@ void CLevel::setLevelSize(float width, float height) {
     levelSize.x = width;
     levelSize.y = height;
     boundaries = sf::FloatRect(0.0f, 0.0f, width, height);
+    platformGridDirty = true;
     createLevelGeometry();
 }
 
@@ -114,6 +137,7 @@ void CLevel::initializePhysics(CPhysics* physics) {
     }
     
     this->physics = physics;
+    enemyPool.setPhysics(physics);
     
     // Crear plataformas fisicas especificas del nivel
     createPhysicalPlatforms();
@@ -145,12 +169,12 @@ void CLevel::createLevelBoundaries() {
     float wallThickness = 10.0f;  // Mas delgados
     
     // Muro izquierdo (fuera de pantalla)
-    b2Body* leftWall = physics->createWall(-wallThickness, 0.0f, wallThickness, levelSize.y);
-    if (leftWall) wallBodies.push_back(leftWall);
+    BodyHandle leftWall = physics->createWall(-wallThickness, 0.0f, wallThickness, levelSize.y);
+    if (leftWall.isValid()) wallBodies.push_back(leftWall);
     
     // Muro derecho (fuera de pantalla)
-    b2Body* rightWall = physics->createWall(levelSize.x, 0.0f, wallThickness, levelSize.y);
-    if (rightWall) wallBodies.push_back(rightWall);
+    BodyHandle rightWall = physics->createWall(levelSize.x, 0.0f, wallThickness, levelSize.y);
+    if (rightWall.isValid()) wallBodies.push_back(rightWall);
 }
 
 // GESTION DEL NIVEL
@@ -160,14 +184,18 @@ void CLevel::loadLevel() {
     }
     
     // Limpiar datos anteriores
-    enemies.clear();
+    clearEnemies();
     spawnPoints.clear();
+    spawnScheduler.clear();
     obstacles.clear();
     
-    // Resetear contadores
+    // Resetear contadores (addSpawnPoint vuelve a sumar totalEnemies)
     levelTime = 0.0f;
     spawnTimer = 0.0f;
-    enemiesKilled = 0;
+    totalEnemies = 0;
+    completionTime = 0.0f;
+    levelStats = LevelStats();
+    spawnStats = EnemySpawnStats{0, 0, 0, 0};
     
     // Configurar nivel especifico
     setupLevelConfiguration();
@@ -175,6 +203,9 @@ void CLevel::loadLevel() {
     // Cargar texturas
     loadLevelTextures();
     
+    // Precargar texturas de enemigos: los spawns no deben tocar el disco
+    CEnemyPool::warmUpTextures();
+    
     // Crear geometria del nivel
     createLevelGeometry();
     
@@ -182,8 +213,16 @@ void CLevel::loadLevel() {
     if (physics) {
         createPhysicalPlatforms();
         createLevelBoundaries();
+        
+        const PlatformMergeStats& stats = getLayout().mergeStats;
+        std::cout << "Colisiones de " << levelName << ": " << stats.platforms << " plataformas -> "
+                  << stats.solids << " cuerpos estaticos, proxies " << stats.proxiesBefore
+                  << " -> " << stats.proxiesAfter << std::endl;
     }
     
+    // Reservas para que los spawns y muertes no toquen el heap ni el allocator de Box2D
+    preallocateEnemies();
+    
     loaded = true;
     setState(LevelState::ACTIVE);
 }
@@ -191,8 +230,9 @@ void CLevel::loadLevel() {
 void CLevel::unloadLevel() {
     if (!loaded) return;
     
-    enemies.clear();
+    clearEnemies();
     spawnPoints.clear();
+    spawnScheduler.clear();
     obstacles.clear();
     
     // Limpiar plataformas fisicas
@@ -215,55 +255,214 @@ void CLevel::startLevel() {
     setState(LevelState::ACTIVE);
 }
 
+// CARGA EN SEGUNDO PLANO
+std::unique_ptr<LevelLayout> CLevel::prepareLayout(int levelNumber, const std::vector<std::string>& residentTextures,
+                                                   bool decodeTextures) {
+    CTraceWriter::getInstance().setThreadName("precarga de nivel");
+    TRACE_SCOPE("CLevel::prepareLayout");
+    
+    auto prepared = std::make_unique<LevelLayout>(levelNumber);
+    buildLayout(*prepared);
+    
+    if (!decodeTextures) {
+        return prepared;
+    }
+    
+    // Decodificar en este hilo (lo caro: disco + PNG); la subida a la GPU queda para el principal
+    for (const std::string& path : prepared->layers) {
+        bool resident = std::find(residentTextures.begin(), residentTextures.end(), path) != residentTextures.end();
+        bool decoded = std::any_of(prepared->images.begin(), prepared->images.end(),
+            [&path](const std::pair<std::string, sf::Image>& image) { return image.first == path; });
+        if (resident || decoded) continue;
+        
+        sf::Image image;
+        if (image.loadFromFile(path)) {
+            prepared->images.emplace_back(path, std::move(image));
+        }
+    }
+    
+    return prepared;
+}
+
+std::vector<std::string> CLevel::getResidentTextures() {
+    return CTextureCache::getInstance().getResidentPaths();
+}
+
+std::string CLevel::getLevelFilePath(int levelNumber, const char* extension) {
+    return "assets/levels/level" + std::to_string(levelNumber) + extension;
+}
+
+void CLevel::setPreparedLayout(std::unique_ptr<LevelLayout> prepared) {
+    if (prepared && prepared->levelNumber == levelNumber) {
+        adoptLayout(std::move(prepared));
+    }
+}
+
+bool CLevel::hasLayout() const {
+    return layout != nullptr;
+}
+
 // GESTION DE ENEMIGOS
 void CLevel::addEnemy(EnemyType type, float x, float y) {
-    auto enemy = std::make_unique<CEnemy>(type, x, y);
+    createEnemy(type, x, y);
+    recordSpawn(type);
+}
+
+CEnemy* CLevel::createEnemy(EnemyType type, float x, float y) {
+    uint64_t allocationsBefore = CAllocationCounter::getThreadCount();
+    size_t bodiesBefore = enemyPool.getBodiesCreated();
+    
+    // Reutilizar una vista retirada; solo se crea una si no queda ninguna
+    std::unique_ptr<CEnemy> enemy;
+    if (!spareEnemies.empty()) {
+        enemy = std::move(spareEnemies.back());
+        spareEnemies.pop_back();
+        enemy->respawn(type, x, y);
+    } else {
+        enemy = std::make_unique<CEnemy>(enemyPool, type, x, y);
+        spawnStats.viewsCreated++;
+    }
     
-    // Inicializar fisicas del enemigo si el sistema esta disponible
+    // Inicializar fisicas del enemigo si el sistema esta disponible (con un cuerpo aparcado si lo hay)
     if (physics) {
         enemy->initializePhysics(physics);
     }
     
+    enemyGrid.insert(enemy.get(), enemy->getPosition());
     enemies.push_back(std::move(enemy));
+    
+    spawnStats.spawns++;
+    spawnStats.bodiesCreated += enemyPool.getBodiesCreated() - bodiesBefore;
+    spawnStats.allocations += CAllocationCounter::getThreadCount() - allocationsBefore;
+    return enemies.back().get();
+}
+
+void CLevel::recordSpawn(EnemyType type) {
+    int index = static_cast<int>(type);
+    levelStats.spawned[index]++;
+    levelStats.alive[index]++;
+    levelStats.totalSpawned++;
+    levelStats.totalAlive++;
+    CEventBus::getInstance().publish(GameEventType::ENEMY_SPAWNED, index);
+}
+
+void CLevel::recordKill(EnemyType type) {
+    int index = static_cast<int>(type);
+    levelStats.killed[index]++;
+    levelStats.alive[index]--;
+    levelStats.totalKilled++;
+    levelStats.totalAlive--;
+    CEventBus::getInstance().publish(GameEventType::ENEMY_KILLED, index);
 }
 
-void CLevel::addSpawnPoint(float x, float y, EnemyType type, float spawnTime) {
-    spawnPoints.emplace_back(x, y, type, spawnTime);
-    totalEnemies++;
+void CLevel::addSpawnPoint(float x, float y, EnemyType type, float spawnTime, uint16_t waveSize,
+                           uint16_t firings, float interval) {
+    spawnScheduler.add(static_cast<uint32_t>(spawnPoints.size()), spawnTime, waveSize, firings, interval);
+    spawnPoints.emplace_back(x, y, type, spawnTime, waveSize, firings, interval);
+    totalEnemies += static_cast<int>(spawnPoints.back().getEnemyCount());
+    levelStats.pendingSpawns = spawnScheduler.getPendingSpawns();
+}
+
+template<typename Predicate>
+void CLevel::retireEnemiesIf(Predicate predicate) {
+    // Compactar a mano: remove_if no deja llevarse los elementos que descarta
+    size_t kept = 0;
+    for (size_t i = 0; i < enemies.size(); i++) {
+        if (enemies[i] && predicate(*enemies[i])) {
+            retireEnemy(enemies[i]);
+            continue;
+        }
+        if (kept != i) {
+            enemies[kept] = std::move(enemies[i]);
+        }
+        kept++;
+    }
+    enemies.resize(kept);
+}
+
+void CLevel::retireEnemy(std::unique_ptr<CEnemy>& enemy) {
+    uint64_t allocationsBefore = CAllocationCounter::getThreadCount();
+    
+    // Se libera su hueco en el pool y su cuerpo queda aparcado; la vista espera al siguiente spawn
+    enemyGrid.remove(enemy.get());
+    enemy->despawn();
+    spareEnemies.push_back(std::move(enemy));
+    
+    spawnStats.allocations += CAllocationCounter::getThreadCount() - allocationsBefore;
 }
 
 void CLevel::removeDeadEnemies() {
-    auto it = std::remove_if(enemies.begin(), enemies.end(),
-        [this](const std::unique_ptr<CEnemy>& enemy) {
-            if (enemy && !enemy->isAlive()) {
-                enemiesKilled++;
-                return true;
-            }
-            return false;
-        });
+    retireEnemiesIf([this](const CEnemy& enemy) {
+        if (enemy.isAlive()) return false;
+        recordKill(enemy.getEnemyType());
+        return true;
+    });
+}
+
+void CLevel::clearEnemies() {
+    enemies.clear();
+    enemyGrid.clear();
+    chunkGrid.clearDormantEnemies();
     
-    enemies.erase(it, enemies.end());
+    // Sin enemigos en el pool todos los cuerpos estan aparcados: se devuelven a Box2D
+    enemyPool.destroySpareBodies();
 }
 
-CEnemy* CLevel::getClosestEnemyToPosition(const sf::Vector2f& position, float maxRange) {
-    CEnemy* closestEnemy = nullptr;
-    float closestDistance = maxRange > 0 ? maxRange : std::numeric_limits<float>::max();
+const EnemySpawnStats& CLevel::getSpawnStats() const {
+    return spawnStats;
+}
+
+void CLevel::preallocateEnemies() {
+    size_t perType[ENEMY_TYPE_COUNT] = {};
+    for (const SpawnPoint& spawnPoint : spawnPoints) {
+        perType[static_cast<int>(spawnPoint.enemyType)] += spawnPoint.getEnemyCount();
+    }
     
-    for (const auto& enemy : enemies) {
-        if (enemy && enemy->isAlive()) {
-            float distance = std::sqrt(
-                std::pow(enemy->getPosition().x - position.x, 2) +
-                std::pow(enemy->getPosition().y - position.y, 2)
-            );
-            
-            if (distance < closestDistance) {
-                closestDistance = distance;
-                closestEnemy = enemy.get();
-            }
+    size_t views = 0;
+    for (int i = 0; i < ENEMY_TYPE_COUNT; i++) {
+        size_t count = std::min(perType[i], MAX_PREALLOCATED_ENEMIES);
+        views += count;
+        if (physics) {
+            enemyPool.preallocateBodies(static_cast<EnemyType>(i), count);
         }
     }
     
-    return closestEnemy;
+    size_t total = static_cast<size_t>(totalEnemies);
+    enemyPool.reserve(total);
+    enemies.reserve(total);
+    spareEnemies.reserve(total);
+    
+    // Las vistas nacen con un enemigo que se suelta enseguida (de paso se resuelven las tablas de frames)
+    while (spareEnemies.size() < views) {
+        EnemyType type = static_cast<EnemyType>(spareEnemies.size() % ENEMY_TYPE_COUNT);
+        auto enemy = std::make_unique<CEnemy>(enemyPool, type, 0.0f, 0.0f);
+        enemy->despawn();
+        spareEnemies.push_back(std::move(enemy));
+        spawnStats.viewsCreated++;
+    }
+}
+
+namespace {
+    // Los enemigos muertos siguen en el hash hasta removeDeadEnemies()
+    bool isEnemyAlive(const CEnemy* enemy) {
+        return enemy->isAlive();
+    }
+}
+
+CEnemy* CLevel::getClosestEnemyToPosition(const sf::Vector2f& position, float maxRange) {
+    return enemyGrid.queryNearest(position, maxRange, isEnemyAlive);
+}
+
+void CLevel::getClosestEnemies(const sf::Vector2f& position, size_t count, float maxRange, std::vector<CEnemy*>& out) const {
+    enemyGrid.queryNearestK(position, count, maxRange, out, isEnemyAlive);
+}
+
+void CLevel::getEnemiesInRadius(const sf::Vector2f& position, float radius, std::vector<CEnemy*>& out) const {
+    enemyGrid.queryRadius(position, radius, out, isEnemyAlive);
+}
+
+void CLevel::getEnemiesInArea(const sf::FloatRect& area, std::vector<CEnemy*>& out) const {
+    enemyGrid.queryRect(area, out, isEnemyAlive);
 }
 
 void CLevel::addPhysicalPlatform(float x, float y, float width, float height, sf::Color color) {
@@ -272,11 +471,21 @@ void CLevel::addPhysicalPlatform(float x, float y, float width, float height, sf
         return;
     }
     
+    attachPlatform(buildPlatform(PlatformDef{sf::FloatRect(x, y, width, height), color}, floorFrame));
+}
+
+PhysicalPlatform CLevel::buildPlatform(const PlatformDef& def, const AtlasFrame& floor) {
+    float x = def.rect.left;
+    float y = def.rect.top;
+    float width = def.rect.width;
+    float height = def.rect.height;
+    sf::Color color = def.color;
+    
     // PASO 1: CREAR PLATAFORMA BASE
     PhysicalPlatform platform(x, y, width, height, color);
     
     // PASO 2: CONFIGURAR SPRITE VISUAL MAS GRUESO
-    if (floorTexture.getSize().x > 0) {
+    if (floor.texture) {
         // HACER LA PARTE VISUAL MAS GRUESA HACIA ABAJO
         float visualThickness = 40.0f;  // Grosor visual fijo (puedes cambiar este valor)
         
@@ -284,15 +493,15 @@ void CLevel::addPhysicalPlatform(float x, float y, float width, float height, sf
         float finalVisualHeight = std::max(height, visualThickness);
         
         // Configurar sprite con textura
-        platform.floorSprite.setTexture(floorTexture);
+        platform.floorSprite.setTexture(*floor.texture);
+        platform.floorSprite.setTextureRect(floor.rect);
         
         // POSICIONAR: La parte SUPERIOR del visual coincide con la fisica
         platform.floorSprite.setPosition(x, y);  // Misma posicion superior
         
         // ESCALAR: Ajustar a nuevo tamano visual
-        sf::Vector2u textureSize = floorTexture.getSize(); // 336x112
-        float scaleX = width / textureSize.x;                // Ancho igual
-        float scaleY = finalVisualHeight / textureSize.y;    // Altura aumentada
+        float scaleX = width / floor.rect.width;                    // Ancho igual (336x112)
+        float scaleY = finalVisualHeight / floor.rect.height;       // Altura aumentada
         
         platform.floorSprite.setScale(scaleX, scaleY);
         platform.hasTexture = true;
@@ -317,20 +526,28 @@ void CLevel::addPhysicalPlatform(float x, float y, float width, float height, sf
         platform.hasTexture = false;
     }
     
+    return platform;
+}
+
+bool CLevel::attachPlatform(PhysicalPlatform platform) {
     // PASO 3: CREAR CUERPO FISICO (TAMANO ORIGINAL - NO CAMBIAR)
-    platform.physicsBody = physics->createPlatform(x, y, width, height);  // Fisica original
+    platform.physicsHandle = physics->createPlatform(platform.position.x, platform.position.y,
+                                                     platform.size.x, platform.size.y);  // Fisica original
+    platform.physicsBody = physics->getBody(platform.physicsHandle);
     
-    if (platform.physicsBody) {
-        platforms.push_back(platform);
-    } else {
+    if (!platform.physicsBody) {
         std::cerr << "ERROR: No se pudo crear cuerpo fisico" << std::endl;
+        return false;
     }
+    
+    platforms.push_back(std::move(platform));
+    platformGridDirty = true;
+    return true;
 }
 
 void CLevel::clearPhysicalPlatforms() {
-    // No necesitamos destruir los cuerpos manualmente aqui porque
-    // CPhysics se encarga de eso cuando se destruye el mundo
-    platforms.clear();
+    // Destruir tambien los cuerpos: si no, cada recarga dejaba plataformas duplicadas en el mundo
+    destroyPhysicalPlatforms();
 }
 
 // GESTION DE OBSTACULOS (solo visuales, sin fisicas)
@@ -366,17 +583,8 @@ bool CLevel::isPositionInBounds(const sf::Vector2f& position) const {
 void CLevel::checkLevelCompletion() {
     if (state != LevelState::ACTIVE) return;
     
-    // Verificar si todos los enemigos han sido spawneados
-    bool allSpawned = true;
-    for (const auto& spawnPoint : spawnPoints) {
-        if (!spawnPoint.hasSpawned) {
-            allSpawned = false;
-            break;
-        }
-    }
-    
     // Si todos fueron spawneados y no hay enemigos vivos, nivel completado
-    if (allSpawned && getEnemiesAlive() == 0) {
+    if (levelStats.pendingSpawns == 0 && levelStats.totalAlive == 0) {
         setState(LevelState::COMPLETED);
     }
 }
@@ -387,6 +595,9 @@ void CLevel::update(float deltaTime, const sf::Vector2f& playerPosition) {
     
     levelTime += deltaTime;
     
+    // Cargar/descargar chunks alrededor del jugador antes de tocar enemigos
+    streamAround(playerPosition, deltaTime);
+    
     // Spawn enemigos segun tiempo
     spawnEnemiesFromPoints(deltaTime);
     
@@ -400,40 +611,75 @@ void CLevel::update(float deltaTime, const sf::Vector2f& playerPosition) {
     checkLevelCompletion();
 }
 
-void CLevel::render(sf::RenderWindow& window) {
+void CLevel::render(sf::RenderTarget& target) {
+    TRACE_SCOPE("CLevel::render");
+    
     if (!loaded) return;
     
-    // Renderizar fondos
-    if (texturesLoaded) {
-        window.draw(layer1Sprite);
-        window.draw(layer2Sprite);
-    } else {
-        window.draw(background);
-    }
+    spriteBatch.resetStats();
+    
+    // Renderizar fondos (solo las repeticiones que se ven)
+    renderBackground(target, CCamera::getVisibleArea(target.getView()));
     
     // Renderizar plataformas con texturas
-    renderPlatforms(window);
+    renderPlatforms(target);
     
     // COMENTAR/ELIMINAR ESTA LINEA PARA QUITAR LOS CUADRADOS GRISES:
-    // renderObstacles(window);  // <- COMENTA ESTA LINEA
+    // renderObstacles(target);  // <- COMENTA ESTA LINEA
     
     // Renderizar enemigos
-    renderEnemies(window);
+    renderEnemies(target);
     
     // Renderizar borde del nivel
-    window.draw(border);
+    target.draw(border);
+}
+
+void CLevel::renderBackground(sf::RenderTarget& target, const sf::FloatRect& visibleArea) {
+    if (!texturesLoaded) {
+        target.draw(background);
+        return;
+    }
+    
+    for (BackgroundLayer& layer : backgroundLayers) {
+        if (layer.tileWidth <= 0.0f) continue;
+        
+        // Repeticiones que tocan la vista, sin pasar de los límites del nivel
+        int lastTile = static_cast<int>(std::ceil(levelSize.x / layer.tileWidth)) - 1;
+        int firstVisible = std::max(0, static_cast<int>(std::floor(visibleArea.left / layer.tileWidth)));
+        int lastVisible = std::min(lastTile, static_cast<int>(std::floor((visibleArea.left + visibleArea.width) / layer.tileWidth)));
+        
+        for (int tile = firstVisible; tile <= lastVisible; tile++) {
+            layer.sprite.setPosition(tile * layer.tileWidth, 0.0f);
+            target.draw(layer.sprite);
+        }
+    }
 }
 
-void CLevel::renderPlatforms(sf::RenderWindow& window) {
-    for (const auto& platform : platforms) {
+void CLevel::renderPlatforms(sf::RenderTarget& target) {
+    if (platformGridDirty) {
+        rebuildPlatformGrid();
+    }
+    
+    // Solo las plataformas de las celdas que toca la vista (en su orden original)
+    platformGrid.query(getCullArea(target), visiblePlatforms);
+    
+    for (uint32_t index : visiblePlatforms) {
+        const PhysicalPlatform& platform = platforms[index];
         if (platform.hasTexture) {
             // Renderizar con textura de floor.png
-            window.draw(platform.floorSprite);
+            spriteBatch.draw(platform.floorSprite);
         } else {
-            // Fallback: renderizar rectangulo de color
-            window.draw(platform.shape);
+            // Fallback: rectangulo de color con borde
+            spriteBatch.drawRect(sf::FloatRect(platform.position, platform.size), platform.shape.getFillColor(),
+                                 platform.shape.getOutlineThickness(), platform.shape.getOutlineColor());
         }
     }
+    
+    spriteBatch.flush(target);
+}
+
+const SpriteBatchStats& CLevel::getRenderStats() const {
+    return spriteBatch.getStats();
 }
 
 // DEBUG
@@ -445,19 +691,51 @@ void CLevel::printLevelInfo() const {
     std::cout << "Tiempo: " << levelTime << "s" << std::endl;
     std::cout << "Tamano: " << levelSize.x << "x" << levelSize.y << std::endl;
     std::cout << "Enemigos totales: " << totalEnemies << std::endl;
-    std::cout << "Enemigos eliminados: " << enemiesKilled << std::endl;
-    std::cout << "Enemigos vivos: " << getEnemiesAlive() << std::endl;
+    std::cout << "Enemigos eliminados: " << levelStats.totalKilled << std::endl;
+    std::cout << "Enemigos vivos: " << levelStats.totalAlive << " (dormidos: " << chunkGrid.getDormantCount() << ")" << std::endl;
+    for (int i = 0; i < ENEMY_TYPE_COUNT; i++) {
+        std::cout << "  " << CEnemyPool::getTypeInfo(static_cast<EnemyType>(i)).name << ": " << levelStats.spawned[i]
+                  << " spawneados, " << levelStats.alive[i] << " vivos, " << levelStats.killed[i] << " eliminados" << std::endl;
+    }
+    std::cout << "Enemigos activos: " << enemyPool.getActiveCount() << " (congelados: " << enemyPool.getFrozenCount() << ")" << std::endl;
+    std::cout << "Chunks cargados: " << chunkGrid.getLoadedCount() << "/" << chunkGrid.getChunkCount() << std::endl;
     std::cout << "Progreso: " << getCompletionPercentage() << "%" << std::endl;
+    std::cout << "Spawns pendientes: " << spawnScheduler.getPendingSpawns() << " enemigos (disparos en cola "
+              << spawnScheduler.getQueuedCount() << ", esperando chunk " << spawnScheduler.getDeferredCount() << ")" << std::endl;
+    std::cout << "Spawns: " << spawnStats.spawns << " (vistas creadas " << spawnStats.viewsCreated
+              << ", cuerpos creados " << enemyPool.getBodiesCreated() << " (en spawns " << spawnStats.bodiesCreated
+              << "), reciclados " << enemyPool.getBodiesRecycled()
+              << "), reservas de C++ en spawns y retiradas: " << spawnStats.allocations << std::endl;
+    enemyPool.getAIScheduler().printStats();
     std::cout << "===========================" << std::endl;
 }
 
 void CLevel::printEnemyCount() const {
     std::cout << "Enemigos en " << levelName << ": " 
               << getEnemiesAlive() << " vivos, " 
-              << enemiesKilled << " eliminados" << std::endl;
+              << levelStats.totalKilled << " eliminados" << std::endl;
+}
+
+void CLevel::printTelemetry() const {
+    LevelTelemetry telemetry = getTelemetry();
+    std::cout << "Telemetria de " << levelName << ": " << telemetry.kills << " eliminados en "
+              << telemetry.playTime << "s (" << telemetry.killsPerMinute << " por minuto)";
+    if (telemetry.timeToClear >= 0.0f) {
+        std::cout << ", completado en " << telemetry.timeToClear << "s";
+    }
+    std::cout << std::endl;
 }
 
 void CLevel::printPhysicsInfo() const {
+    if (layout) {
+        const PlatformMergeStats& stats = layout->mergeStats;
+        std::cout << "Colisiones fusionadas: " << stats.platforms << " plataformas -> " << stats.solids
+                  << " cuerpos, proxies " << stats.proxiesBefore << " -> " << stats.proxiesAfter << std::endl;
+    }
+    if (physics) {
+        std::cout << "Proxies en el broadphase: " << physics->getProxyCount() << std::endl;
+    }
+    
     if (!platforms.empty()) {
         std::cout << "--- Detalle de plataformas ---" << std::endl;
         for (size_t i = 0; i < platforms.size(); i++) {
@@ -469,41 +747,53 @@ void CLevel::printPhysicsInfo() const {
 }
 
 // METODOS PRIVADOS
+const LevelLayout& CLevel::getLayout() {
+    if (!layout) {
+        auto built = std::make_unique<LevelLayout>(levelNumber);
+        buildLayout(*built);
+        adoptLayout(std::move(built));
+    }
+    return *layout;
+}
+
+void CLevel::adoptLayout(std::unique_ptr<LevelLayout> adopted) {
+    layout = std::move(adopted);
+    
+    // Los limites del archivo valen desde ya: los muros se crean antes de loadLevel()
+    levelSize = layout->size;
+    boundaries = sf::FloatRect(0.0f, 0.0f, levelSize.x, levelSize.y);
+    platformGridDirty = true;
+}
+
 void CLevel::setupLevelConfiguration() {
-    switch (levelNumber) {
-        case 1:
-            configureLevel1();
-            break;
-        case 2:
-            configureLevel2();
-            break;
-        case 3:
-            configureLevel3();
-            break;
-        default:
-            configureDefaultLevel();
-            break;
+    const LevelLayout& current = getLayout();
+    
+    if (!current.name.empty()) {
+        levelName = current.name;
+    }
+    spawnScheduler.reserve(current.spawnPoints.size());
+    spawnPoints.reserve(current.spawnPoints.size());
+    for (const SpawnPoint& spawn : current.spawnPoints) {
+        addSpawnPoint(spawn.position.x, spawn.position.y, spawn.enemyType, spawn.spawnTime,
+                      spawn.waveSize, spawn.firings, spawn.interval);
+    }
+    for (const sf::FloatRect& obstacle : current.obstacles) {
+        addObstacle(obstacle.left, obstacle.top, obstacle.width, obstacle.height);
     }
 }
 
 void CLevel::createLevelGeometry() {
     // Si las texturas estan cargadas, usar sprites; si no, usar rectangulos de color
     if (texturesLoaded) {
-        // Configurar sprites de fondo
-        layer1Sprite.setTexture(layer1Texture);
-        layer2Sprite.setTexture(layer2Texture);
-        
-        // Escalar las imagenes para que cubran toda la pantalla
-        sf::Vector2u layer1Size = layer1Texture.getSize();
-        sf::Vector2u layer2Size = layer2Texture.getSize();
-        
-        float scaleX1 = levelSize.x / layer1Size.x;
-        float scaleY1 = levelSize.y / layer1Size.y;
-        layer1Sprite.setScale(scaleX1, scaleY1);
-        
-        float scaleX2 = levelSize.x / layer2Size.x;
-        float scaleY2 = levelSize.y / layer2Size.y;
-        layer2Sprite.setScale(scaleX2, scaleY2);
+        // Cada imagen cubre una pantalla de ancho (o todo el nivel si es mas estrecho) y la altura
+        // del nivel; en niveles mas anchos se repite y render() solo dibuja las repeticiones visibles
+        for (BackgroundLayer& layer : backgroundLayers) {
+            layer.sprite.setTexture(*layer.texture);
+            layer.tileWidth = std::min(levelSize.x, BACKGROUND_TILE_WIDTH);
+            
+            sf::Vector2u layerSize = layer.texture->getSize();
+            layer.sprite.setScale(layer.tileWidth / layerSize.x, levelSize.y / layerSize.y);
+        }
         
     } else {
         // Fallback: configurar fondo de color solido MAS VISIBLE
@@ -520,64 +810,182 @@ void CLevel::createLevelGeometry() {
     border.setOutlineColor(sf::Color::Yellow);
 }
 
-void CLevel::loadLevelTextures() {
-    texturesLoaded = true; // Assume success, set to false if any fails
+void CLevel::uploadLayoutImages() {
+    if (!layout || layout->images.empty()) return;
     
-    // CARGAR TEXTURA DEL SUELO/PLATAFORMAS
-    if (!floorTexture.loadFromFile("assets/floor.png")) {
-        std::cerr << "Error: No se pudo cargar assets/floor.png" << std::endl;
-        texturesLoaded = false;
+    // Imágenes decodificadas por prepareLayout(): solo falta la subida a la GPU
+    CTextureCache& cache = CTextureCache::getInstance();
+    for (const auto& pair : layout->images) {
+        cache.insert(pair.first, pair.second);
     }
+    layout->images.clear();
+}
+
+void CLevel::loadLevelTextures() {
+    uploadLayoutImages();
+    
+    // Las texturas vienen del cache compartido: solo el primer nivel las decodifica
+    CTextureCache& cache = CTextureCache::getInstance();
     
-    // Cargar layer 1 (fondo lejano)
-    if (!layer1Texture.loadFromFile("assets/layer_1.png")) {
-        std::cerr << "Error: No se pudo cargar assets/layer_1.png" << std::endl;
-        texturesLoaded = false;
+    // CARGAR TEXTURA DEL SUELO/PLATAFORMAS (del atlas si está empaquetada)
+    std::vector<AtlasFrame> floorFrames;
+    if (!CTextureAtlas::getInstance().getStripFrames("floor", floorFrames)) {
+        floorTexture = cache.acquire("assets/floor.png");
+        if (floorTexture) {
+            sf::Vector2u size = floorTexture->getSize();
+            CTextureAtlas::sliceStrip(floorTexture.get(), {"floor", 0, 0, 1, static_cast<int>(size.x), static_cast<int>(size.y)}, floorFrames);
+        }
     }
+    floorFrame = floorFrames.empty() ? AtlasFrame{nullptr, sf::IntRect(0, 0, 0, 0)} : floorFrames.front();
     
-    // Cargar layer 2 (fondo cercano)
-    if (!layer2Texture.loadFromFile("assets/layer_2.png")) {
-        std::cerr << "Error: No se pudo cargar assets/layer_2.png" << std::endl;
-        texturesLoaded = false;
+    // Cargar fondos del layout (de atras hacia delante)
+    backgroundLayers.clear();
+    bool layersLoaded = !getLayout().layers.empty();
+    for (const std::string& path : getLayout().layers) {
+        BackgroundLayer layer;
+        layer.texture = cache.acquire(path);
+        layersLoaded = layersLoaded && layer.texture;
+        backgroundLayers.push_back(std::move(layer));
     }
+    
+    texturesLoaded = floorFrame.texture && layersLoaded;
+}
+
+void CLevel::registerAtlasSheets() {
+    // Los fondos (layer_1/layer_2) son imágenes completas y se quedan como texturas sueltas
+    CTextureAtlas::getInstance().addSheet("assets/floor.png", {
+        {"floor", 0, 0, 1, FLOOR_TEXTURE_WIDTH, FLOOR_TEXTURE_HEIGHT}
+    });
 }
 
 void CLevel::spawnEnemiesFromPoints(float deltaTime) {
     spawnTimer += deltaTime;
     
-    for (auto& spawnPoint : spawnPoints) {
-        if (!spawnPoint.hasSpawned && spawnTimer >= spawnPoint.spawnTime) {
-            addEnemy(spawnPoint.enemyType, spawnPoint.position.x, spawnPoint.position.y);
-            spawnPoint.hasSpawned = true;
+    // Solo se tocan los disparos vencidos (cima del heap)
+    bool streaming = chunkGrid.getChunkCount() > 0;
+    SpawnEvent event;
+    while (spawnScheduler.popDue(spawnTimer, event)) {
+        // Los spawns de chunks descargados esperan en su chunk a que el jugador se acerque
+        if (streaming) {
+            int chunk = chunkGrid.getChunkAt(spawnPoints[event.spawner].position);
+            if (!chunkGrid.isLoaded(chunk)) {
+                spawnScheduler.defer(chunk, event);
+                continue;
+            }
         }
+        fireSpawn(event);
     }
 }
 
+void CLevel::fireSpawn(const SpawnEvent& event) {
+    const SpawnPoint& spawnPoint = spawnPoints[event.spawner];
+    
+    // Oleada centrada en el punto, en fila horizontal
+    float firstX = spawnPoint.position.x - (event.waveSize - 1) * WAVE_SPACING * 0.5f;
+    for (uint16_t i = 0; i < event.waveSize; i++) {
+        addEnemy(spawnPoint.enemyType, firstX + i * WAVE_SPACING, spawnPoint.position.y);
+    }
+    
+    spawnScheduler.complete(event);
+    levelStats.pendingSpawns = spawnScheduler.getPendingSpawns();
+}
+
 void CLevel::updateEnemies(float deltaTime, const sf::Vector2f& playerPosition) {
-    for (auto& enemy : enemies) {
-        if (enemy && enemy->isAlive()) {
-            enemy->updateAI(playerPosition, deltaTime);
-            enemy->update(deltaTime);
-            
-            // Sincronizar posicion del enemigo con fisicas
-            if (physics) {
-                enemy->syncPositionFromPhysics();
-            }
+    updateEnemyLOD(playerPosition);
+    
+    // IA escalonada por cubos de distancia; despues cooldowns y animacion de los activos
+    enemyPool.updateAI(playerPosition, deltaTime);
+    enemyPool.update(deltaTime);
+    
+    // Sin fisicas la IA mueve a los enemigos directamente
+    if (!physics) {
+        refreshEnemyGrid();
+    }
+}
+
+void CLevel::syncEnemiesFromPhysics() {
+    if (!physics) return;
+    
+    // Sincronizar posicion de los enemigos con el ultimo paso de fisicas
+    enemyPool.syncFromPhysics();
+    
+    refreshEnemyGrid();
+}
+
+void CLevel::refreshEnemyGrid() {
+    // Los congelados no se mueven: su celda sigue siendo valida
+    for (size_t i = 0; i < enemyPool.getActiveCount(); i++) {
+        if (enemyPool.isAliveAt(i)) {
+            enemyGrid.update(enemyPool.getOwnerAt(i), enemyPool.getPositionAt(i));
         }
     }
 }
 
-void CLevel::renderEnemies(sf::RenderWindow& window) {
+void CLevel::updateEnemyLOD(const sf::Vector2f& playerPosition) {
+    // Despertar al instante a los que entran en el radio: el hash solo visita las celdas cercanas
+    enemyGrid.queryRadius(playerPosition, CEnemyPool::WAKE_DISTANCE, nearbyEnemies, isEnemyAlive);
+    for (CEnemy* enemy : nearbyEnemies) {
+        enemyPool.wake(enemyPool.indexOf(enemy->getId()));
+    }
+    
+    enemyPool.freezeDistant(playerPosition);
+}
+
+uint64_t CLevel::hashState(uint64_t hash) const {
+    hash = CReplay::hashValue(hash, levelStats.totalKilled);
+    
     for (const auto& enemy : enemies) {
-        if (enemy && enemy->isAlive()) {
-            enemy->render(window);
+        if (!enemy || !enemy->isAlive()) continue;
+        
+        hash = CReplay::hashValue(hash, enemy->getHealth());
+        hash = CReplay::hashValue(hash, enemy->getMovementDirection());
+        
+        // Estado exacto del cuerpo fisico: cualquier bit distinto indica divergencia
+        b2Body* body = enemy->getPhysicsBody();
+        if (body) {
+            hash = CReplay::hashValue(hash, body->GetPosition());
+            hash = CReplay::hashValue(hash, body->GetLinearVelocity());
         }
     }
+    
+    return hash;
+}
+
+void CLevel::renderEnemies(sf::RenderTarget& target) {
+    // Enemigos vivos cerca de la vista segun el hash espacial, en el orden del pool
+    enemyGrid.queryRect(getCullArea(target), visibleEnemies, isEnemyAlive);
+    
+    visibleEnemyIndices.clear();
+    for (CEnemy* enemy : visibleEnemies) {
+        visibleEnemyIndices.push_back(enemyPool.indexOf(enemy->getId()));
+    }
+    std::sort(visibleEnemyIndices.begin(), visibleEnemyIndices.end());
+    
+    enemyPool.render(spriteBatch, visibleEnemyIndices);
+    spriteBatch.flush(target);
+}
+
+void CLevel::rebuildPlatformGrid() {
+    // Las plataformas no se mueven: la rejilla solo cambia al crearlas, destruirlas o cambiar su grosor
+    platformGrid.reset(boundaries);
+    for (size_t i = 0; i < platforms.size(); i++) {
+        const PhysicalPlatform& platform = platforms[i];
+        sf::FloatRect visual = platform.hasTexture ? platform.floorSprite.getGlobalBounds()
+                                                   : platform.shape.getGlobalBounds();
+        platformGrid.insert(static_cast<uint32_t>(i), visual);
+    }
+    platformGridDirty = false;
+}
+
+sf::FloatRect CLevel::getCullArea(const sf::RenderTarget& target) {
+    sf::FloatRect area = CCamera::getVisibleArea(target.getView());
+    return sf::FloatRect(area.left - CULL_MARGIN, area.top - CULL_MARGIN,
+                         area.width + 2.0f * CULL_MARGIN, area.height + 2.0f * CULL_MARGIN);
 }
 
-void CLevel::renderObstacles(sf::RenderWindow& window) {
+void CLevel::renderObstacles(sf::RenderTarget& target) {
     for (const auto& obstacle : obstacles) {
-        window.draw(obstacle);
+        target.draw(obstacle);
     }
 }
 
@@ -592,170 +1000,370 @@ std::string CLevel::levelStateToString(LevelState state) const {
 }
 
 void CLevel::setupPhysicalPlatformsForLevel() {
-    switch (levelNumber) {
-        case 1:
-            configurePlatformsLevel1();
-            break;
-        case 2:
-            configurePlatformsLevel2();
-            break;
-        case 3:
-            configurePlatformsLevel3();
-            break;
-        default:
-            // Configuracion basica para niveles generados
-            addPhysicalPlatform(0.0f, 550.0f, 800.0f, 50.0f, sf::Color::Green);
-            addPhysicalPlatform(300.0f, 400.0f, 200.0f, 20.0f, sf::Color::Yellow);
-            break;
+    const LevelLayout& current = getLayout();
+    
+    // Repartir las plataformas en chunks; solo se crean las de los chunks cercanos al foco
+    stopStreaming();
+    chunkGrid.reset(boundaries);
+    for (size_t i = 0; i < current.platforms.size(); i++) {
+        chunkGrid.addPlatform(static_cast<uint32_t>(i), current.platforms[i].rect);
+    }
+    for (size_t i = 0; i < current.solids.size(); i++) {
+        chunkGrid.addSolid(static_cast<uint32_t>(i), current.solids[i].bounds);
     }
+    platformRefs.assign(current.platforms.size(), 0);
+    solidRefs.assign(current.solids.size(), 0);
+    solidBodies.assign(current.solids.size(), BodyHandle());
+    
+    streamFocus = sf::Vector2f(DEFAULT_FOCUS_X, DEFAULT_FOCUS_Y);
+    streamDirection = sf::Vector2f(0.0f, 0.0f);
+    streamAround(streamFocus, 0.0f);
 }
 
 void CLevel::destroyPhysicalPlatforms() {
     // Limpiar plataformas visuales y fisicas
     for (auto& platform : platforms) {
-        if (platform.physicsBody && physics) {
-            // Destruir cuerpo fisico especificamente
-            physics->destroyBody(platform.physicsBody);
+        if (physics) {
+            // Destruir cuerpo fisico especificamente (O(1) por handle)
+            physics->destroyBody(platform.physicsHandle);
         }
     }
     
     platforms.clear();
+    platformGridDirty = true;
+    destroySolidBodies();
+    stopStreaming();
 }
 
 void CLevel::destroyLevelBoundaries() {
-    // Los cuerpos se destruyen automaticamente con el mundo de Box2D
+    if (physics) {
+        for (BodyHandle wall : wallBodies) {
+            physics->destroyBody(wall);
+        }
+    }
     wallBodies.clear();
 }
 
-// CONFIGURACIONES ESPECIFICAS POR NIVEL
-void CLevel::configureLevel1() {
-    // Solo unos pocos enemigos para empezar
-    addSpawnPoint(200.0f, 150.0f, EnemyType::MURCIELAGO, 2.0f);
-    addSpawnPoint(600.0f, 200.0f, EnemyType::ESQUELETO, 5.0f);
-    addSpawnPoint(400.0f, 350.0f, EnemyType::ZOMBIE, 8.0f);
-    
-    // Un obstaculo simple (visual, sin fisicas)
-    addObstacle(350.0f, 250.0f, 100.0f, 50.0f);
-}
-
-void CLevel::configureLevel2() {
-    // Mas enemigos y variedad
-    addSpawnPoint(100.0f, 100.0f, EnemyType::MURCIELAGO, 1.0f);
-    addSpawnPoint(700.0f, 100.0f, EnemyType::MURCIELAGO, 2.0f);
-    addSpawnPoint(300.0f, 200.0f, EnemyType::ESQUELETO, 3.0f);
-    addSpawnPoint(500.0f, 200.0f, EnemyType::ESQUELETO, 5.0f);
-    addSpawnPoint(400.0f, 400.0f, EnemyType::ZOMBIE, 8.0f);
-    
-    // Mas obstaculos visuales
-    addObstacle(200.0f, 150.0f, 100.0f, 30.0f);
-    addObstacle(500.0f, 150.0f, 100.0f, 30.0f);
-    addObstacle(350.0f, 350.0f, 100.0f, 100.0f);
-}
-
-void CLevel::configureLevel3() {
-    // Nivel dificil con muchos enemigos
-    addSpawnPoint(100.0f, 100.0f, EnemyType::MURCIELAGO, 1.0f);
-    addSpawnPoint(700.0f, 100.0f, EnemyType::MURCIELAGO, 1.5f);
-    addSpawnPoint(100.0f, 500.0f, EnemyType::MURCIELAGO, 2.0f);
-    addSpawnPoint(700.0f, 500.0f, EnemyType::MURCIELAGO, 2.5f);
-    addSpawnPoint(200.0f, 200.0f, EnemyType::ESQUELETO, 3.0f);
-    addSpawnPoint(600.0f, 200.0f, EnemyType::ESQUELETO, 4.0f);
-    addSpawnPoint(200.0f, 400.0f, EnemyType::ZOMBIE, 5.0f);
-    addSpawnPoint(600.0f, 400.0f, EnemyType::ZOMBIE, 6.0f);
-    addSpawnPoint(400.0f, 300.0f, EnemyType::ZOMBIE, 10.0f); // Jefe final
-    
-    // Laberinto de obstaculos visuales
-    addObstacle(150.0f, 150.0f, 80.0f, 20.0f);
-    addObstacle(570.0f, 150.0f, 80.0f, 20.0f);
-    addObstacle(300.0f, 100.0f, 20.0f, 100.0f);
-    addObstacle(480.0f, 100.0f, 20.0f, 100.0f);
-    addObstacle(300.0f, 400.0f, 200.0f, 20.0f);
-}
-
-void CLevel::configureDefaultLevel() {
-    levelName = "Nivel " + std::to_string(levelNumber) + " - Generado";
+// STREAMING POR CHUNKS
+void CLevel::streamAround(const sf::Vector2f& focus, float deltaTime) {
+    if (chunkGrid.getChunkCount() == 0 || !physics) return;
     
-    // Configuracion escalable basada en el numero de nivel
-    int numEnemies = 2 + levelNumber;
+    TRACE_SCOPE("CLevel::streamAround");
     
-    for (int i = 0; i < numEnemies; i++) {
-        float x = 100.0f + std::fmod((i * 150.0f), 600.0f);
-        float y = 100.0f + (i % 3) * 150.0f;
-        EnemyType type = static_cast<EnemyType>(i % 3);
-        float spawnTime = 1.0f + i * 2.0f;
+    // Direccion de avance: ultimo desplazamiento real del foco
+    sf::Vector2f step = focus - streamFocus;
+    if (deltaTime > 0.0f && (step.x != 0.0f || step.y != 0.0f)) {
+        streamDirection = step;
+    }
+    streamFocus = focus;
+    
+    collectPrefetchedChunk();
+    
+    // Primero descargar (libera cuerpos) y luego cargar lo que falte alrededor del foco
+    chunkGrid.getChunksToUnload(focus, chunkScratch);
+    for (int chunk : chunkScratch) {
+        unloadChunk(chunk);
+    }
+    
+    chunkGrid.getChunksToLoad(focus, chunkScratch);
+    for (int chunk : chunkScratch) {
+        loadChunk(chunk);
+    }
+    
+    sleepEnemiesOutsideLoadedChunks();
+    
+    // Preparar en otro hilo el siguiente chunk en la direccion de avance
+    int next = chunkGrid.getPrefetchChunk(focus, streamDirection);
+    if (next != CChunkGrid::NO_CHUNK && !chunkGrid.isLoaded(next) &&
+        next != preparedChunk.chunk && next != pendingChunkIndex) {
+        prefetchChunk(next);
+    }
+}
+
+size_t CLevel::getLoadedChunkCount() const {
+    return chunkGrid.getLoadedCount();
+}
+
+size_t CLevel::getChunkCount() const {
+    return chunkGrid.getChunkCount();
+}
+
+void CLevel::loadChunk(int chunk) {
+    chunkGrid.setLoaded(chunk, true);
+    
+    // Colision: un cuerpo por solido fusionado, compartido entre los chunks que toca
+    for (uint32_t index : chunkGrid.getSolids(chunk)) {
+        if (solidRefs[index]++ == 0) {
+            solidBodies[index] = createSolidBody(layout->solids[index]);
+        }
+    }
+    
+    // Plataformas visuales (pueden venir ya hechas de la precarga)
+    const std::vector<uint32_t>& indices = chunkGrid.getPlatforms(chunk);
+    bool prepared = preparedChunk.chunk == chunk && preparedChunk.platforms.size() == indices.size();
+    
+    for (size_t i = 0; i < indices.size(); i++) {
+        uint32_t index = indices[i];
+        if (platformRefs[index]++ > 0) continue;     // Ya cargada por otro chunk que tambien toca
         
-        addSpawnPoint(x, y, type, spawnTime);
+        PhysicalPlatform platform = prepared ? std::move(preparedChunk.platforms[i])
+                                             : buildPlatform(layout->platforms[index], floorFrame);
+        platform.layoutIndex = static_cast<int>(index);
+        platforms.push_back(std::move(platform));
+        platformGridDirty = true;
     }
     
-    // Algunos obstaculos aleatorios
-    for (int i = 0; i < levelNumber; i++) {
-        float x = 200.0f + std::fmod((i * 200.0f), 400.0f);
-        float y = 200.0f + std::fmod((i * 100.0f), 200.0f);
-        addObstacle(x, y, 60.0f, 60.0f);
+    if (preparedChunk.chunk == chunk) {
+        preparedChunk = PreparedChunk();
+    }
+    
+    // Despertar a los enemigos que se durmieron al descargar el chunk
+    chunkGrid.takeDormantEnemies(chunk, dormantScratch);
+    for (const DormantEnemy& dormant : dormantScratch) {
+        createEnemy(static_cast<EnemyType>(dormant.type), dormant.x, dormant.y)->setHealth(dormant.health);
+    }
+    
+    // Spawns que vencieron con el chunk descargado: salen ahora y sus repeticiones cuentan desde aqui
+    spawnScheduler.takeDeferred(chunk, spawnScratch);
+    for (SpawnEvent& event : spawnScratch) {
+        event.time = spawnTimer;
+        fireSpawn(event);
+    }
+}
+
+void CLevel::unloadChunk(int chunk) {
+    chunkGrid.setLoaded(chunk, false);
+    
+    // Sus enemigos se duermen en sleepEnemiesOutsideLoadedChunks() (tambien los que entraron desde otro chunk)
+    for (uint32_t index : chunkGrid.getPlatforms(chunk)) {
+        if (platformRefs[index] > 0 && --platformRefs[index] == 0) {
+            removeLayoutPlatform(index);
+        }
+    }
+    
+    for (uint32_t index : chunkGrid.getSolids(chunk)) {
+        if (solidRefs[index] > 0 && --solidRefs[index] == 0) {
+            if (physics) {
+                physics->destroyBody(solidBodies[index]);
+            }
+            solidBodies[index] = BodyHandle();
+        }
+    }
+}
+
+BodyHandle CLevel::createSolidBody(const PlatformSolid& solid) {
+    if (solid.outline.empty()) {
+        return physics->createPlatform(solid.bounds.left, solid.bounds.top, solid.bounds.width, solid.bounds.height);
     }
+    return physics->createPlatformLoop(solid.outline);
 }
 
-void CLevel::configurePlatformsLevel1() {
-    // SUELO NEGRO (mantener igual)
-    float groundY = 450.0f;
-    addPhysicalPlatform(0.0f, groundY, 800.0f, 150.0f, sf::Color::Black);
+void CLevel::destroySolidBodies() {
+    if (physics) {
+        for (BodyHandle body : solidBodies) {
+            physics->destroyBody(body);
+        }
+    }
+    solidBodies.clear();
+    solidRefs.clear();
+}
+
+void CLevel::removeLayoutPlatform(uint32_t index) {
+    auto it = std::find_if(platforms.begin(), platforms.end(),
+        [index](const PhysicalPlatform& platform) { return platform.layoutIndex == static_cast<int>(index); });
+    if (it == platforms.end()) return;
     
-    // PLATAFORMAS MAS BAJAS Y ACCESIBLES
-    // Plataforma verde (izquierda) - MAS BAJA
-    addPhysicalPlatform(150.0f, 380.0f, 120.0f, 20.0f, sf::Color::Green);
+    platforms.erase(it);                          // Conserva el orden de dibujado
+    platformGridDirty = true;
+}
+
+void CLevel::sleepEnemiesOutsideLoadedChunks() {
+    retireEnemiesIf([this](const CEnemy& enemy) {
+        // Los muertos los recoge removeDeadEnemies() (cuentan como eliminados)
+        if (!enemy.isAlive()) return false;
+        
+        sf::Vector2f position = enemy.getPosition();
+        int chunk = chunkGrid.getChunkAt(position);
+        if (chunkGrid.isLoaded(chunk)) return false;
+        
+        // Serializar y retirar: la vista y el cuerpo se reciclan para el siguiente spawn
+        chunkGrid.addDormantEnemy(chunk, DormantEnemy{static_cast<uint32_t>(enemy.getEnemyType()),
+                                                      position.x, position.y, enemy.getHealth()});
+        return true;
+    });
+}
+
+void CLevel::prefetchChunk(int chunk) {
+    // Una precarga a la vez; la siguiente se lanza cuando se recoja esta
+    if (pendingChunk.valid() || !layout) return;
+    
+    // Copia de las definiciones: el hilo no toca el layout ni nada del nivel
+    std::vector<PlatformDef> defs;
+    for (uint32_t index : chunkGrid.getPlatforms(chunk)) {
+        defs.push_back(layout->platforms[index]);
+    }
+    
+    try {
+        pendingChunk = std::async(std::launch::async, &CLevel::prepareChunk, chunk, std::move(defs), floorFrame);
+        pendingChunkIndex = chunk;
+    } catch (const std::exception& e) {
+        // Sin hilo disponible el chunk se construira al cargarlo
+        std::cerr << "Aviso: no se pudo precargar el chunk " << chunk << ": " << e.what() << std::endl;
+    }
+}
+
+void CLevel::collectPrefetchedChunk() {
+    if (!pendingChunk.valid() ||
+        pendingChunk.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
     
-    // Plataforma amarilla (centro) - MAS BAJA  
-    addPhysicalPlatform(350.0f, 320.0f, 120.0f, 20.0f, sf::Color::Yellow);
+    try {
+        preparedChunk = pendingChunk.get();
+    } catch (const std::exception& e) {
+        std::cerr << "Aviso: fallo la precarga del chunk " << pendingChunkIndex << ": " << e.what() << std::endl;
+        preparedChunk = PreparedChunk();
+    }
+    pendingChunkIndex = CChunkGrid::NO_CHUNK;
+}
+
+void CLevel::stopStreaming() {
+    if (pendingChunk.valid()) {
+        pendingChunk.wait();
+        pendingChunk = std::future<PreparedChunk>();
+    }
+    pendingChunkIndex = CChunkGrid::NO_CHUNK;
+    preparedChunk = PreparedChunk();
     
-    // Plataforma roja (derecha) - MAS BAJA
-    addPhysicalPlatform(550.0f, 280.0f, 120.0f, 20.0f, sf::Color::Red);
+    chunkGrid = CChunkGrid();
+    platformRefs.clear();
+}
+
+PreparedChunk CLevel::prepareChunk(int chunk, std::vector<PlatformDef> defs, AtlasFrame floor) {
+    CTraceWriter::getInstance().setThreadName("precarga de chunk");
+    TRACE_SCOPE("CLevel::prepareChunk");
+    
+    PreparedChunk prepared;
+    prepared.chunk = chunk;
+    prepared.platforms.reserve(defs.size());
+    for (const PlatformDef& def : defs) {
+        prepared.platforms.push_back(buildPlatform(def, floor));
+    }
+    return prepared;
+}
+
+// CONFIGURACIONES ESPECIFICAS POR NIVEL
+void LevelLayout::addSpawnPoint(float x, float y, EnemyType type, float spawnTime, uint16_t waveSize,
+                                uint16_t firings, float interval) {
+    spawnPoints.emplace_back(x, y, type, spawnTime, waveSize, firings, interval);
+}
+
+void LevelLayout::addObstacle(float x, float y, float width, float height) {
+    obstacles.emplace_back(x, y, width, height);
+}
+
+void LevelLayout::addPlatform(float x, float y, float width, float height, sf::Color color) {
+    platforms.push_back(PlatformDef{sf::FloatRect(x, y, width, height), color});
+}
+
+void CLevel::buildLayout(LevelLayout& layout) {
+    // Primero el binario (sin parseo), después la fuente de texto
+    CLevelFile file;
+    if ((file.loadBinary(getLevelFilePath(layout.levelNumber, CLevelFile::BINARY_EXTENSION)) ||
+         file.loadText(getLevelFilePath(layout.levelNumber, CLevelFile::TEXT_EXTENSION))) &&
+        loadLayoutFile(layout, file)) {
+        mergePlatformSolids(layout);
+        return;
+    }
     
-    // Plataforma cyan (opcional, cerca del suelo)
-    addPhysicalPlatform(250.0f, 400.0f, 100.0f, 20.0f, sf::Color::Cyan);
+    configureDefaultLevel(layout);
+    mergePlatformSolids(layout);
 }
 
-void CLevel::configurePlatformsLevel2() {
-    // Plataforma principal (suelo)
-    addPhysicalPlatform(0.0f, 550.0f, 800.0f, 50.0f, sf::Color::Black);
+void CLevel::mergePlatformSolids(LevelLayout& layout) {
+    // Colisiones: menos cuerpos y proxies que una caja por plataforma (las visuales no cambian)
+    std::vector<sf::FloatRect> rects;
+    rects.reserve(layout.platforms.size());
+    for (const PlatformDef& platform : layout.platforms) {
+        rects.push_back(platform.rect);
+    }
+    layout.mergeStats = CPlatformMerger::merge(rects, layout.solids);
+}
+
+bool CLevel::loadLayoutFile(LevelLayout& layout, const CLevelFile& file) {
+    layout.name = file.getName();
+    layout.size = sf::Vector2f(file.getWidth(), file.getHeight());
     
-    // Plataformas flotantes mas complejas
-    addPhysicalPlatform(100.0f, 450.0f, 120.0f, 20.0f, sf::Color::Yellow);
-    addPhysicalPlatform(300.0f, 380.0f, 120.0f, 20.0f, sf::Color::Yellow);
-    addPhysicalPlatform(500.0f, 320.0f, 120.0f, 20.0f, sf::Color::Red);
-    addPhysicalPlatform(650.0f, 420.0f, 100.0f, 20.0f, sf::Color::Red);
+    const LevelFileLayer* layers = file.getLayers();
+    for (uint32_t i = 0; i < file.getLayerCount(); i++) {
+        layout.layers.push_back(file.getString(layers[i].pathOffset));
+    }
     
-    // Plataforma alta
-    addPhysicalPlatform(350.0f, 200.0f, 100.0f, 20.0f, sf::Color::Red);
+    const LevelFileSpawn* spawns = file.getSpawns();
+    for (uint32_t i = 0; i < file.getSpawnCount(); i++) {
+        if (spawns[i].enemyType >= static_cast<uint32_t>(ENEMY_TYPE_COUNT)) {
+            std::cerr << "Aviso: Nivel " << layout.levelNumber << ": tipo de enemigo invalido " << spawns[i].enemyType << std::endl;
+            continue;
+        }
+        layout.addSpawnPoint(spawns[i].x, spawns[i].y, static_cast<EnemyType>(spawns[i].enemyType), spawns[i].spawnTime,
+                             spawns[i].waveSize, spawns[i].firings, spawns[i].interval);
+    }
+    
+    const LevelFilePlatform* platforms = file.getPlatforms();
+    for (uint32_t i = 0; i < file.getPlatformCount(); i++) {
+        const LevelFilePlatform& platform = platforms[i];
+        layout.addPlatform(platform.x, platform.y, platform.width, platform.height, sf::Color(
+            static_cast<sf::Uint8>(platform.color >> 24), static_cast<sf::Uint8>(platform.color >> 16),
+            static_cast<sf::Uint8>(platform.color >> 8), static_cast<sf::Uint8>(platform.color)));
+    }
+    
+    const LevelFileObstacle* obstacles = file.getObstacles();
+    for (uint32_t i = 0; i < file.getObstacleCount(); i++) {
+        layout.addObstacle(obstacles[i].x, obstacles[i].y, obstacles[i].width, obstacles[i].height);
+    }
+    
+    return true;
 }
 
-void CLevel::configurePlatformsLevel3() {
-    // Plataforma principal (suelo)
-    addPhysicalPlatform(0.0f, 550.0f, 800.0f, 50.0f, sf::Color::Black);
+void CLevel::configureDefaultLevel(LevelLayout& layout) {
+    layout.name = "Nivel " + std::to_string(layout.levelNumber) + " - Generado";
+    layout.layers = {"assets/layer_1.png", "assets/layer_2.png"};
     
-    // Laberinto vertical
-    addPhysicalPlatform(50.0f, 480.0f, 100.0f, 15.0f, sf::Color::Yellow);
-    addPhysicalPlatform(200.0f, 420.0f, 100.0f, 15.0f, sf::Color::Yellow);
-    addPhysicalPlatform(350.0f, 360.0f, 100.0f, 15.0f, sf::Color::Red);
-    addPhysicalPlatform(500.0f, 300.0f, 100.0f, 15.0f, sf::Color::Red);
-    addPhysicalPlatform(650.0f, 240.0f, 100.0f, 15.0f, sf::Color::Red);
+    // Configuracion basica de plataformas
+    layout.addPlatform(0.0f, 550.0f, 800.0f, 50.0f, sf::Color::Green);
+    layout.addPlatform(300.0f, 400.0f, 200.0f, 20.0f, sf::Color::Yellow);
+    
+    // Configuracion escalable basada en el numero de nivel
+    int numEnemies = 2 + layout.levelNumber;
+    
+    for (int i = 0; i < numEnemies; i++) {
+        float x = 100.0f + std::fmod((i * 150.0f), 600.0f);
+        float y = 100.0f + (i % 3) * 150.0f;
+        EnemyType type = static_cast<EnemyType>(i % 3);
+        float spawnTime = 1.0f + i * 2.0f;
+        
+        layout.addSpawnPoint(x, y, type, spawnTime);
+    }
     
-    // Plataformas de retorno
-    addPhysicalPlatform(400.0f, 180.0f, 150.0f, 15.0f, sf::Color::Magenta);
-    addPhysicalPlatform(150.0f, 320.0f, 80.0f, 15.0f, sf::Color::Cyan);
-    addPhysicalPlatform(600.0f, 400.0f, 80.0f, 15.0f, sf::Color::Cyan);
+    // Algunos obstaculos aleatorios
+    for (int i = 0; i < layout.levelNumber; i++) {
+        float x = 200.0f + std::fmod((i * 200.0f), 400.0f);
+        float y = 200.0f + std::fmod((i * 100.0f), 200.0f);
+        layout.addObstacle(x, y, 60.0f, 60.0f);
+    }
 }
 
 void CLevel::adjustPlatformThickness(float deltaThickness) {
     for (auto& platform : platforms) {
-        if (platform.hasTexture && floorTexture.getSize().x > 0) {
+        if (platform.hasTexture && floorFrame.texture) {
             // Ajustar escala Y del sprite
             sf::Vector2f currentScale = platform.floorSprite.getScale();
-            sf::Vector2u textureSize = floorTexture.getSize();
+            float frameHeight = static_cast<float>(floorFrame.rect.height);
             
             // Calcular nueva altura visual
-            float currentVisualHeight = currentScale.y * textureSize.y;
+            float currentVisualHeight = currentScale.y * frameHeight;
             float newVisualHeight = std::max(20.0f, currentVisualHeight + deltaThickness);
-            float newScaleY = newVisualHeight / textureSize.y;
+            float newScaleY = newVisualHeight / frameHeight;
             
             platform.floorSprite.setScale(currentScale.x, newScaleY);
             
@@ -764,4 +1372,6 @@ void CLevel::adjustPlatformThickness(float deltaThickness) {
             platform.shape.setSize(sf::Vector2f(shapeSize.x, newVisualHeight));
         }
     }
+    
+    platformGridDirty = true;
 }
\ No newline at end of file
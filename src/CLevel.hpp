@@ -3,12 +3,23 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <future>
 #include <SFML/Graphics.hpp>
 #include "CEnemy.hpp"
+#include "CTextureCache.hpp"
 #include <box2d/box2d.h>  // ← NUEVO: Box2D
-
-// Forward declaration
-class CPhysics;
+#include "CPhysics.hpp"       // BodyHandle
+#include "CSpatialHash.hpp"
+#include "CStaticGrid.hpp"
+#include "CChunkGrid.hpp"
+#include "CSpawnScheduler.hpp"
+#include "CPlatformMerger.hpp"
+#include "CSpriteBatch.hpp"
+#include "CTextureAtlas.hpp"
+#include "CLevelFile.hpp"
 
 enum class LevelState {
     LOADING,
@@ -17,14 +28,20 @@ enum class LevelState {
     FAILED
 };
 
+// Punto de spawn: una oleada de waveSize enemigos en spawnTime, repetida firings veces cada interval segundos
 struct SpawnPoint {
     sf::Vector2f position;
     EnemyType enemyType;
     float spawnTime;
-    bool hasSpawned;
+    uint16_t waveSize;
+    uint16_t firings;
+    float interval;
+    
+    SpawnPoint(float x, float y, EnemyType type, float time = 0.0f, uint16_t waveSize = 1, uint16_t firings = 1,
+               float interval = 0.0f)
+        : position(x, y), enemyType(type), spawnTime(time), waveSize(waveSize), firings(firings), interval(interval) {}
     
-    SpawnPoint(float x, float y, EnemyType type, float time = 0.0f) 
-        : position(x, y), enemyType(type), spawnTime(time), hasSpawned(false) {}
+    size_t getEnemyCount() const { return static_cast<size_t>(waveSize) * firings; }
 };
 
 // ===================================
@@ -33,14 +50,16 @@ struct SpawnPoint {
 struct PhysicalPlatform {
     sf::RectangleShape shape;    // Representación visual de respaldo
     sf::Sprite floorSprite;      // ← NUEVO: Sprite con textura de floor
+    BodyHandle physicsHandle;    // Handle del cuerpo en CPhysics
     b2Body* physicsBody;         // Cuerpo físico
     sf::Vector2f position;
     sf::Vector2f size;
     sf::Color color;
     bool hasTexture;             // ← NUEVO: Si tiene textura cargada
+    int layoutIndex;             // Índice en LevelLayout::platforms (-1: añadida a mano, con cuerpo propio)
     
     PhysicalPlatform(float x, float y, float w, float h, sf::Color c = sf::Color::Green)
-        : physicsBody(nullptr), position(x, y), size(w, h), color(c), hasTexture(false) {
+        : physicsBody(nullptr), position(x, y), size(w, h), color(c), hasTexture(false), layoutIndex(-1) {
         // Configurar shape de respaldo
         shape.setPosition(x, y);
         shape.setSize(sf::Vector2f(w, h));
@@ -49,6 +68,83 @@ struct PhysicalPlatform {
         shape.setOutlineColor(sf::Color::Black);
     }
 };
+// Plataforma del layout: solo datos, el cuerpo físico se crea al cargar el nivel
+struct PlatformDef {
+    sf::FloatRect rect;
+    sf::Color color;
+};
+
+// Plataformas de un chunk preparadas en el hilo de precarga (sin cuerpo físico)
+struct PreparedChunk {
+    int chunk = CChunkGrid::NO_CHUNK;
+    std::vector<PhysicalPlatform> platforms;     // Mismo orden que CChunkGrid::getPlatforms(chunk)
+};
+
+// Coste de los spawns y retiradas de enemigos (las vistas y los cuerpos se reciclan)
+struct EnemySpawnStats {
+    size_t spawns;
+    size_t viewsCreated;         // CEnemy nuevos; el resto de spawns reutilizan uno retirado
+    size_t bodiesCreated;        // Cuerpos de Box2D nuevos en spawns (pasan por b2Alloc); el resto se reciclan
+    uint64_t allocations;        // Reservas de C++ (operator new) dentro de spawns y retiradas; no incluye b2Alloc
+};
+
+// Contadores del nivel, al día con cada spawn y cada muerte: consultarlos no recorre los enemigos
+struct LevelStats {
+    int spawned[ENEMY_TYPE_COUNT];
+    int killed[ENEMY_TYPE_COUNT];
+    int alive[ENEMY_TYPE_COUNT];         // Incluye los dormidos en chunks descargados
+    int totalSpawned;
+    int totalKilled;
+    int totalAlive;
+    size_t pendingSpawns;                // Enemigos de los spawn points que aún no han salido
+};
+
+// Telemetría de una partida al nivel
+struct LevelTelemetry {
+    int levelNumber;
+    float playTime;                      // Segundos jugados
+    float timeToClear;                   // Segundos hasta completarlo (negativo si aún no)
+    int kills;
+    float killsPerMinute;
+};
+
+// Capa de fondo: textura compartida escalada a la altura del nivel y repetida en horizontal
+struct BackgroundLayer {
+    TextureHandle texture;
+    sf::Sprite sprite;
+    float tileWidth = 0.0f;      // Ancho de cada repetición en el mundo
+};
+
+// ===================================
+// Layout de un nivel (solo datos)
+// ===================================
+// Lo que hace falta para montar un nivel sin tocar Box2D ni la GPU: límites,
+// fondos, spawns, obstáculos, plataformas y las imágenes ya decodificadas de
+// las texturas que aún no estaban en el cache. Sale de assets/levels/levelN.cvl
+// (o .txt, ver CLevelFile); si no hay archivo, de configureDefaultLevel().
+// CLevel::prepareLayout() lo construye en un hilo aparte; en el hilo principal
+// solo quedan los cuerpos físicos y la subida de las imágenes a la GPU.
+struct LevelLayout {
+    int levelNumber;
+    std::string name;                               // Vacío: se mantiene "Nivel N"
+    sf::Vector2f size;
+    std::vector<std::string> layers;                // Texturas de fondo, de atrás hacia delante
+    std::vector<SpawnPoint> spawnPoints;
+    std::vector<sf::FloatRect> obstacles;
+    std::vector<PlatformDef> platforms;
+    std::vector<PlatformSolid> solids;              // Colisión de las plataformas ya fusionada (CPlatformMerger)
+    PlatformMergeStats mergeStats;
+    std::vector<std::pair<std::string, sf::Image>> images;  // Ruta + imagen decodificada (aún sin subir)
+    
+    explicit LevelLayout(int levelNumber)
+        : levelNumber(levelNumber), size(800.0f, 600.0f), mergeStats{0, 0, 0, 0} {}
+    
+    void addSpawnPoint(float x, float y, EnemyType type, float spawnTime = 0.0f, uint16_t waveSize = 1,
+                       uint16_t firings = 1, float interval = 0.0f);
+    void addObstacle(float x, float y, float width, float height);
+    void addPlatform(float x, float y, float width, float height, sf::Color color = sf::Color::Green);
+};
+
 class CLevel {
 private:
     // Información del nivel
@@ -61,21 +157,51 @@ private:
     // ===================================
     CPhysics* physics;                         // Referencia al sistema de físicas
     std::vector<PhysicalPlatform> platforms;   // Plataformas con físicas
-    std::vector<b2Body*> wallBodies;          // Muros invisibles (límites)
+    std::vector<BodyHandle> wallBodies;       // Muros invisibles (límites)
     
     // Dimensiones y límites
     sf::Vector2f levelSize;
     sf::FloatRect boundaries;
     
+    // Layout (se construye una vez y se reutiliza en cada recarga)
+    std::unique_ptr<LevelLayout> layout;
+    
     // Enemigos y spawn points
+    CEnemyPool enemyPool;                      // Datos de los enemigos (SoA); declarado antes que las vistas
     std::vector<std::unique_ptr<CEnemy>> enemies;
+    std::vector<std::unique_ptr<CEnemy>> spareEnemies;  // Vistas sin enemigo en el pool, para el siguiente spawn
     std::vector<SpawnPoint> spawnPoints;
+    CSpawnScheduler spawnScheduler;            // Próximo disparo de cada spawn point, por tiempo
+    std::vector<SpawnEvent> spawnScratch;      // Disparos aparcados de un chunk al cargarlo
+    CSpatialHash<CEnemy> enemyGrid;            // Enemigos por celdas para consultas de proximidad
+    CStaticGrid platformGrid;                  // Índices de plataformas por celdas (culling)
+    bool platformGridDirty;                    // Se reconstruye en el siguiente render()
+    
+    // Resultados del culling, reutilizados entre frames
+    std::vector<uint32_t> visiblePlatforms;
+    std::vector<CEnemy*> visibleEnemies;
+    std::vector<size_t> visibleEnemyIndices;
+    std::vector<CEnemy*> nearbyEnemies;        // Candidatos a despertar (LOD), reutilizado entre frames
+    
+    // Streaming por chunks: solo los chunks cercanos al jugador tienen cuerpos, plataformas y enemigos
+    CChunkGrid chunkGrid;
+    std::vector<uint16_t> platformRefs;        // Chunks cargados que tocan cada plataforma del layout
+    std::vector<uint16_t> solidRefs;           // Lo mismo para cada sólido de colisión del layout
+    std::vector<BodyHandle> solidBodies;       // Cuerpo de cada sólido (inválido si no está cargado)
+    sf::Vector2f streamFocus;
+    sf::Vector2f streamDirection;              // Último desplazamiento del foco (dirección de avance)
+    std::future<PreparedChunk> pendingChunk;   // Precarga en curso (como mucho una)
+    int pendingChunkIndex;
+    PreparedChunk preparedChunk;               // Última precarga terminada, a la espera de cargar su chunk
+    std::vector<int> chunkScratch;
+    std::vector<DormantEnemy> dormantScratch;
     
     // Tiempo y progreso
     float levelTime;
     float spawnTimer;
     int totalEnemies;
-    int enemiesKilled;
+    LevelStats levelStats;
+    EnemySpawnStats spawnStats;
     
     // Gráficos del nivel
     sf::RectangleShape background;
@@ -83,22 +209,39 @@ private:
     std::vector<sf::RectangleShape> obstacles;  // Obstáculos visuales (sin físicas)
     
     // Texturas y sprites para fondos
-    sf::Texture layer1Texture;
-    sf::Texture layer2Texture;
-    sf::Sprite layer1Sprite;
-    sf::Sprite layer2Sprite;
-    sf::Texture floorTexture;
+    std::vector<BackgroundLayer> backgroundLayers;  // Texturas compartidas entre niveles (cache de texturas)
+    TextureHandle floorTexture;                // Solo si floor.png no está en el atlas
+    AtlasFrame floorFrame;                     // Textura + rectángulo del suelo (atlas u hoja suelta)
     bool texturesLoaded;
+    CSpriteBatch spriteBatch;                  // Plataformas y enemigos: una llamada a draw por textura y capa
     
     // Configuración
     bool loaded;
     float completionTime;
     
 public:
+    // floor.png: una sola imagen de 336x112
+    static const int FLOOR_TEXTURE_WIDTH = 336;
+    static const int FLOOR_TEXTURE_HEIGHT = 112;
+    
+    // Culling: margen alrededor de la vista (sprites de enemigos más grandes que su
+    // posición guardada y ajustes de alineación de las plataformas)
+    static constexpr float CULL_MARGIN = 128.0f;
+    static constexpr float BACKGROUND_TILE_WIDTH = 800.0f;   // Una pantalla por repetición del fondo
+    
+    // Foco del streaming al cargar, hasta que CGame coloca al jugador
+    static constexpr float DEFAULT_FOCUS_X = 400.0f;
+    static constexpr float DEFAULT_FOCUS_Y = 300.0f;
+    static constexpr size_t MAX_PREALLOCATED_ENEMIES = 64;      // Vistas y cuerpos de reserva por tipo al cargar
+    static constexpr float WAVE_SPACING = 40.0f;                // Separación horizontal entre los enemigos de una oleada
+    
     // Constructor y destructor
     CLevel(int levelNumber);
     ~CLevel();
     
+    // Atlas de texturas: registrar floor.png antes de CTextureAtlas::build()
+    static void registerAtlasSheets();
+    
     // Getters
     int getLevelNumber() const;
     const std::string& getLevelName() const;
@@ -109,6 +252,9 @@ public:
     int getTotalEnemies() const;
     int getEnemiesKilled() const;
     int getEnemiesAlive() const;
+    size_t getPendingSpawns() const;             // Enemigos de los spawn points que aún no han salido
+    const LevelStats& getLevelStats() const;
+    LevelTelemetry getTelemetry() const;
     float getCompletionPercentage() const;
     bool isLoaded() const;
     bool isCompleted() const;
@@ -136,13 +282,36 @@ public:
     void resetLevel();
     void startLevel();
     
+    // Carga en segundo plano: prepareLayout() no toca estado compartido y puede
+    // ejecutarse en otro hilo; getResidentTextures() y setPreparedLayout() van en el principal
+    static std::unique_ptr<LevelLayout> prepareLayout(int levelNumber, const std::vector<std::string>& residentTextures,
+                                                      bool decodeTextures);
+    static std::vector<std::string> getResidentTextures();  // Texturas que el hilo de carga no debe decodificar
+    static std::string getLevelFilePath(int levelNumber, const char* extension);
+    void setPreparedLayout(std::unique_ptr<LevelLayout> prepared);
+    bool hasLayout() const;
+    
+    // Streaming por chunks (ver CChunkGrid): carga los chunks alrededor del foco, descarga los
+    // lejanos (sus enemigos quedan dormidos) y precarga en otro hilo el siguiente en la dirección de avance
+    void streamAround(const sf::Vector2f& focus, float deltaTime);
+    size_t getLoadedChunkCount() const;
+    size_t getChunkCount() const;
+    
     
     // Gestión de enemigos
     void addEnemy(EnemyType type, float x, float y);
-    void addSpawnPoint(float x, float y, EnemyType type, float spawnTime = 0.0f);
+    void addSpawnPoint(float x, float y, EnemyType type, float spawnTime = 0.0f, uint16_t waveSize = 1,
+                       uint16_t firings = 1, float interval = 0.0f);
     void removeDeadEnemies();
+    void clearEnemies();                         // Destruye también sus cuerpos físicos
+    const EnemySpawnStats& getSpawnStats() const;
     CEnemy* getClosestEnemyToPosition(const sf::Vector2f& position, float maxRange = -1.0f);
     
+    // Consultas de proximidad sobre el hash espacial (solo enemigos vivos)
+    void getClosestEnemies(const sf::Vector2f& position, size_t count, float maxRange, std::vector<CEnemy*>& out) const;
+    void getEnemiesInRadius(const sf::Vector2f& position, float radius, std::vector<CEnemy*>& out) const;
+    void getEnemiesInArea(const sf::FloatRect& area, std::vector<CEnemy*>& out) const;
+    
     // ===================================
     // NUEVO: Gestión de plataformas físicas
     // ===================================
@@ -159,48 +328,75 @@ public:
     
     // Métodos SFML
     void update(float deltaTime, const sf::Vector2f& playerPosition);
-    void render(sf::RenderWindow& window);
+    void updateEnemies(float deltaTime, const sf::Vector2f& playerPosition);  // IA y animación (sin spawns)
+    void syncEnemiesFromPhysics();                // Tras el paso de físicas (posiciones interpoladas)
+    uint64_t hashState(uint64_t hash) const;      // Mezcla el estado de los enemigos en un hash (replays)
+    void render(sf::RenderTarget& target);          // Solo lo que cae dentro de la vista actual de target
     void adjustPlatformThickness(float deltaThickness);  // ← NUEVA
     // ===================================
     // NUEVO: Renderizado específico
     // ===================================
-    void renderPlatforms(sf::RenderWindow& window);  // Renderizar plataformas físicas
+    void renderPlatforms(sf::RenderTarget& target);  // Renderizar plataformas físicas visibles
+    const SpriteBatchStats& getRenderStats() const;  // Llamadas a draw y vértices del último render()
     
     // Debug
     void printLevelInfo() const;
     void printEnemyCount() const;
+    void printTelemetry() const;
     void printPhysicsInfo() const;               // ← NUEVO: Info de físicas del nivel
     
 private:
     // Métodos privados de configuración
+    const LevelLayout& getLayout();              // Lo construye en este hilo si no se precargó
+    void adoptLayout(std::unique_ptr<LevelLayout> adopted);
     void setupLevelConfiguration();
     void createLevelGeometry();
+    void uploadLayoutImages();
     void loadLevelTextures();
     void spawnEnemiesFromPoints(float deltaTime);
-    void updateEnemies(float deltaTime, const sf::Vector2f& playerPosition);
-    void renderEnemies(sf::RenderWindow& window);
-    void renderObstacles(sf::RenderWindow& window);
+    void fireSpawn(const SpawnEvent& event);     // Crea la oleada y reprograma el spawn point
+    void renderBackground(sf::RenderTarget& target, const sf::FloatRect& visibleArea);
+    void renderEnemies(sf::RenderTarget& target);
+    void rebuildPlatformGrid();
+    static sf::FloatRect getCullArea(const sf::RenderTarget& target);  // Vista actual más CULL_MARGIN
+    void refreshEnemyGrid();                     // Reubica en el hash los enemigos que cambiaron de celda
+    void preallocateEnemies();                   // Vistas y cuerpos de reserva según los spawn points
+    CEnemy* createEnemy(EnemyType type, float x, float y);  // Sin contarlo como spawn (enemigos dormidos)
+    void recordSpawn(EnemyType type);
+    void recordKill(EnemyType type);
+    void retireEnemy(std::unique_ptr<CEnemy>& enemy);  // Lo saca del pool y del hash y guarda la vista
+    template<typename Predicate>
+    void retireEnemiesIf(Predicate predicate);   // Retira (conservando el orden del resto) los que cumplan predicate
+    void updateEnemyLOD(const sf::Vector2f& playerPosition);  // Despierta los cercanos y congela los lejanos
+    void renderObstacles(sf::RenderTarget& target);
     std::string levelStateToString(LevelState state) const;
     
     // ===================================
     // NUEVO: Métodos privados de físicas
     // ===================================
-    void setupPhysicalPlatformsForLevel();       // Configurar plataformas específicas del nivel
+    void setupPhysicalPlatformsForLevel();       // Reparte las plataformas en chunks y carga los del foco
+    static PhysicalPlatform buildPlatform(const PlatformDef& def, const AtlasFrame& floor);  // Solo la parte visual
+    bool attachPlatform(PhysicalPlatform platform);   // Crea el cuerpo físico y la añade al nivel
+    BodyHandle createSolidBody(const PlatformSolid& solid);
+    void destroySolidBodies();
     void destroyPhysicalPlatforms();             // Destruir plataformas físicas
     void destroyLevelBoundaries();               // Destruir límites
     
-    // Configuraciones específicas por nivel (actualizadas)
-    void configureLevel1();
-    void configureLevel2();
-    void configureLevel3();
-    void configureDefaultLevel();
+    // Construcción del layout: archivo de nivel o, si no existe, nivel generado
+    static void buildLayout(LevelLayout& layout);
+    static bool loadLayoutFile(LevelLayout& layout, const CLevelFile& file);
+    static void configureDefaultLevel(LevelLayout& layout);
+    static void mergePlatformSolids(LevelLayout& layout);
     
-    // ===================================
-    // NUEVO: Configuraciones de plataformas por nivel
-    // ===================================
-    void configurePlatformsLevel1();
-    void configurePlatformsLevel2();
-    void configurePlatformsLevel3();
+    // Streaming por chunks
+    void loadChunk(int chunk);
+    void unloadChunk(int chunk);
+    void removeLayoutPlatform(uint32_t index);      // Solo la parte visual: la colisión va por sólidos
+    void sleepEnemiesOutsideLoadedChunks();
+    void prefetchChunk(int chunk);
+    void collectPrefetchedChunk();
+    void stopStreaming();                        // Espera la precarga en curso y olvida los chunks
+    static PreparedChunk prepareChunk(int chunk, std::vector<PlatformDef> defs, AtlasFrame floor);
 };
 
 #endif // CLEVEL_HPP
\ No newline at end of file
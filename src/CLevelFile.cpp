@@ -0,0 +1,417 @@
+#include "CLevelFile.hpp"
+#include "CEnemyPool.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cctype>
+#include <cmath>
+
+namespace {
+    const char MAGIC[4] = {'C', 'V', 'L', 'V'};
+
+    static_assert(sizeof(LevelFileHeader) == 60, "LevelFileHeader debe ser compacto");
+    static_assert(sizeof(LevelFileSpawn) == 24, "LevelFileSpawn debe ser compacto");
+    static_assert(sizeof(LevelFilePlatform) == 20, "LevelFilePlatform debe ser compacto");
+    static_assert(sizeof(LevelFileObstacle) == 16, "LevelFileObstacle debe ser compacto");
+    static_assert(sizeof(LevelFileLayer) == 4, "LevelFileLayer debe ser compacto");
+
+    struct NamedColor {
+        const char* name;
+        uint32_t rgba;
+    };
+
+    const NamedColor NAMED_COLORS[] = {
+        {"black", 0x000000FF}, {"white", 0xFFFFFFFF}, {"red", 0xFF0000FF}, {"green", 0x00FF00FF},
+        {"blue", 0x0000FFFF}, {"yellow", 0xFFFF00FF}, {"magenta", 0xFF00FFFF}, {"cyan", 0x00FFFFFF}
+    };
+
+    std::string toLower(std::string text) {
+        for (char& c : text) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return text;
+    }
+
+    // Número entero en [minimum, maximum] (sin los desbordes silenciosos de leer un unsigned)
+    bool readCount(std::istream& stream, int minimum, int maximum, uint16_t& out) {
+        int value;
+        if (!(stream >> value) || value < minimum || value > maximum) return false;
+        out = static_cast<uint16_t>(value);
+        return true;
+    }
+
+    // Resto de una línea spawn: [segundos] [oleada <n>] [cada <segundos> <disparos>]
+    bool parseSpawnOptions(std::istringstream& stream, LevelFileSpawn& spawn) {
+        std::string token;
+        bool first = true;
+        while (stream >> token) {
+            token = toLower(token);
+            if (token == "oleada") {
+                if (!readCount(stream, 1, UINT16_MAX, spawn.waveSize)) return false;
+            } else if (token == "cada") {
+                if (!(stream >> spawn.interval) || spawn.interval <= 0.0f) return false;
+                if (!readCount(stream, 1, UINT16_MAX, spawn.firings)) return false;
+            } else if (first) {
+                std::istringstream number(token);
+                if (!(number >> spawn.spawnTime) || !(number >> std::ws).eof()) return false;
+            } else {
+                return false;
+            }
+            first = false;
+        }
+        return true;
+    }
+
+    // Lo que CSpawnScheduler necesita de un spawn: al menos un enemigo y un disparo,
+    // tiempos finitos y no negativos, e intervalo si repite (mismas reglas que el texto)
+    bool isValidSpawn(const LevelFileSpawn& spawn) {
+        return std::isfinite(spawn.x) && std::isfinite(spawn.y) &&
+               std::isfinite(spawn.spawnTime) && spawn.spawnTime >= 0.0f &&
+               std::isfinite(spawn.interval) && spawn.interval >= 0.0f &&
+               spawn.waveSize >= 1 && spawn.firings >= 1 &&
+               (spawn.firings == 1 || spawn.interval > 0.0f);
+    }
+
+    bool endsWith(const std::string& text, const char* suffix) {
+        size_t length = std::strlen(suffix);
+        return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+    }
+
+    // Una sección cabe en el archivo y está alineada a 4 bytes
+    bool sectionFits(uint32_t offset, uint32_t count, size_t recordSize, size_t fileSize) {
+        uint64_t end = static_cast<uint64_t>(offset) + static_cast<uint64_t>(count) * recordSize;
+        return offset % 4 == 0 && end <= fileSize;
+    }
+
+    size_t alignTo4(size_t value) {
+        return (value + 3) & ~static_cast<size_t>(3);
+    }
+}
+
+const char* const CLevelFile::BINARY_EXTENSION = ".cvl";
+const char* const CLevelFile::TEXT_EXTENSION = ".txt";
+
+// Constructor
+CLevelFile::CLevelFile() : byteSize(0), header(nullptr) {
+}
+
+// CARGA Y GUARDADO
+bool CLevelFile::load(const std::string& path) {
+    return endsWith(path, BINARY_EXTENSION) ? loadBinary(path) : loadText(path);
+}
+
+bool CLevelFile::loadBinary(const std::string& path) {
+    header = nullptr;
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Una sola lectura de todo el archivo: no hay parseo campo a campo
+    std::streamoff size = file.tellg();
+    if (size < static_cast<std::streamoff>(sizeof(LevelFileHeader))) {
+        std::cerr << "CLevelFile: " << path << " es demasiado corto" << std::endl;
+        return false;
+    }
+
+    byteSize = static_cast<size_t>(size);
+    storage.assign(alignTo4(byteSize) / 4, 0);
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(storage.data()), static_cast<std::streamsize>(byteSize));
+    if (!file) {
+        std::cerr << "CLevelFile: Error leyendo " << path << std::endl;
+        return false;
+    }
+
+    return adoptStorage(path);
+}
+
+bool CLevelFile::loadText(const std::string& path) {
+    header = nullptr;
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    float width = 800.0f;
+    float height = 600.0f;
+    std::vector<LevelFileSpawn> spawns;
+    std::vector<LevelFilePlatform> platforms;
+    std::vector<LevelFileObstacle> obstacles;
+    std::vector<LevelFileLayer> layers;
+
+    // Tabla de cadenas: el offset 0 es siempre la cadena vacía
+    std::string strings(1, '\0');
+    auto addString = [&strings](const std::string& text) {
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings += text;
+        strings += '\0';
+        return offset;
+    };
+    uint32_t nameOffset = 0;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        // Solo comentarios de línea completa: '#' también empieza los colores #RRGGBB
+        size_t first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[first] == '#') continue;
+
+        std::istringstream stream(line);
+        std::string keyword;
+        if (!(stream >> keyword)) continue;
+        keyword = toLower(keyword);
+
+        bool ok = true;
+        if (keyword == "name") {
+            std::string name;
+            std::getline(stream >> std::ws, name);
+            nameOffset = addString(name);
+        } else if (keyword == "size") {
+            ok = static_cast<bool>(stream >> width >> height) && width > 0.0f && height > 0.0f;
+        } else if (keyword == "layer") {
+            std::string texturePath;
+            ok = static_cast<bool>(stream >> texturePath);
+            if (ok) {
+                layers.push_back(LevelFileLayer{addString(texturePath)});
+            }
+        } else if (keyword == "platform") {
+            LevelFilePlatform platform{0.0f, 0.0f, 0.0f, 0.0f, 0x00FF00FF};
+            std::string color;
+            ok = static_cast<bool>(stream >> platform.x >> platform.y >> platform.width >> platform.height);
+            if (ok && stream >> color) {
+                ok = parseColor(color, platform.color);
+            }
+            if (ok) {
+                platforms.push_back(platform);
+            }
+        } else if (keyword == "obstacle") {
+            LevelFileObstacle obstacle{0.0f, 0.0f, 0.0f, 0.0f};
+            ok = static_cast<bool>(stream >> obstacle.x >> obstacle.y >> obstacle.width >> obstacle.height);
+            if (ok) {
+                obstacles.push_back(obstacle);
+            }
+        } else if (keyword == "spawn") {
+            LevelFileSpawn spawn{0.0f, 0.0f, 0.0f, 0, 0.0f, 1, 1};
+            std::string type;
+            ok = static_cast<bool>(stream >> type >> spawn.x >> spawn.y) && parseEnemyType(type, spawn.enemyType) &&
+                 parseSpawnOptions(stream, spawn) && isValidSpawn(spawn);
+            if (ok) {
+                spawns.push_back(spawn);
+            }
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            std::cerr << "CLevelFile: " << path << ":" << lineNumber << ": linea invalida: " << line << std::endl;
+            return false;
+        }
+    }
+
+    // Empaquetar: cabecera | spawns | plataformas | obstáculos | capas | cadenas
+    size_t spawnOffset = sizeof(LevelFileHeader);
+    size_t platformOffset = spawnOffset + spawns.size() * sizeof(LevelFileSpawn);
+    size_t obstacleOffset = platformOffset + platforms.size() * sizeof(LevelFilePlatform);
+    size_t layerOffset = obstacleOffset + obstacles.size() * sizeof(LevelFileObstacle);
+    size_t stringOffset = layerOffset + layers.size() * sizeof(LevelFileLayer);
+    byteSize = alignTo4(stringOffset + strings.size());
+
+    storage.assign(byteSize / 4, 0);
+    char* bytes = reinterpret_cast<char*>(storage.data());
+
+    LevelFileHeader packed;
+    std::memcpy(packed.magic, MAGIC, sizeof(MAGIC));
+    packed.version = FORMAT_VERSION;
+    packed.flags = 0;
+    packed.width = width;
+    packed.height = height;
+    packed.nameOffset = nameOffset;
+    packed.spawnOffset = static_cast<uint32_t>(spawnOffset);
+    packed.spawnCount = static_cast<uint32_t>(spawns.size());
+    packed.platformOffset = static_cast<uint32_t>(platformOffset);
+    packed.platformCount = static_cast<uint32_t>(platforms.size());
+    packed.obstacleOffset = static_cast<uint32_t>(obstacleOffset);
+    packed.obstacleCount = static_cast<uint32_t>(obstacles.size());
+    packed.layerOffset = static_cast<uint32_t>(layerOffset);
+    packed.layerCount = static_cast<uint32_t>(layers.size());
+    packed.stringOffset = static_cast<uint32_t>(stringOffset);
+    packed.stringSize = static_cast<uint32_t>(strings.size());
+
+    std::memcpy(bytes, &packed, sizeof(packed));
+    if (!spawns.empty()) std::memcpy(bytes + spawnOffset, spawns.data(), spawns.size() * sizeof(LevelFileSpawn));
+    if (!platforms.empty()) std::memcpy(bytes + platformOffset, platforms.data(), platforms.size() * sizeof(LevelFilePlatform));
+    if (!obstacles.empty()) std::memcpy(bytes + obstacleOffset, obstacles.data(), obstacles.size() * sizeof(LevelFileObstacle));
+    if (!layers.empty()) std::memcpy(bytes + layerOffset, layers.data(), layers.size() * sizeof(LevelFileLayer));
+    std::memcpy(bytes + stringOffset, strings.data(), strings.size());
+
+    return adoptStorage(path);
+}
+
+bool CLevelFile::saveBinary(const std::string& path) const {
+    if (!header) {
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "CLevelFile: No se pudo crear " << path << std::endl;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(storage.data()), static_cast<std::streamsize>(byteSize));
+    if (!file) {
+        std::cerr << "CLevelFile: Error escribiendo " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool CLevelFile::isLoaded() const {
+    return header != nullptr;
+}
+
+// ACCESO A LOS REGISTROS
+float CLevelFile::getWidth() const {
+    return header ? header->width : 0.0f;
+}
+
+float CLevelFile::getHeight() const {
+    return header ? header->height : 0.0f;
+}
+
+const char* CLevelFile::getName() const {
+    return header ? getString(header->nameOffset) : "";
+}
+
+uint32_t CLevelFile::getSpawnCount() const {
+    return header ? header->spawnCount : 0;
+}
+
+const LevelFileSpawn* CLevelFile::getSpawns() const {
+    return header ? reinterpret_cast<const LevelFileSpawn*>(sectionData(header->spawnOffset)) : nullptr;
+}
+
+uint32_t CLevelFile::getPlatformCount() const {
+    return header ? header->platformCount : 0;
+}
+
+const LevelFilePlatform* CLevelFile::getPlatforms() const {
+    return header ? reinterpret_cast<const LevelFilePlatform*>(sectionData(header->platformOffset)) : nullptr;
+}
+
+uint32_t CLevelFile::getObstacleCount() const {
+    return header ? header->obstacleCount : 0;
+}
+
+const LevelFileObstacle* CLevelFile::getObstacles() const {
+    return header ? reinterpret_cast<const LevelFileObstacle*>(sectionData(header->obstacleOffset)) : nullptr;
+}
+
+uint32_t CLevelFile::getLayerCount() const {
+    return header ? header->layerCount : 0;
+}
+
+const LevelFileLayer* CLevelFile::getLayers() const {
+    return header ? reinterpret_cast<const LevelFileLayer*>(sectionData(header->layerOffset)) : nullptr;
+}
+
+const char* CLevelFile::getString(uint32_t offset) const {
+    if (!header || offset >= header->stringSize) {
+        return "";
+    }
+    return sectionData(header->stringOffset) + offset;
+}
+
+// FORMATO DE TEXTO
+bool CLevelFile::parseColor(const std::string& text, uint32_t& rgba) {
+    if (!text.empty() && text[0] == '#') {
+        std::string hex = text.substr(1);
+        if ((hex.size() != 6 && hex.size() != 8) || hex.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos) {
+            return false;
+        }
+        uint32_t value = static_cast<uint32_t>(std::stoul(hex, nullptr, 16));
+        rgba = hex.size() == 6 ? ((value << 8) | 0xFF) : value;
+        return true;
+    }
+
+    std::string name = toLower(text);
+    for (const NamedColor& color : NAMED_COLORS) {
+        if (name == color.name) {
+            rgba = color.rgba;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CLevelFile::parseEnemyType(const std::string& text, uint32_t& type) {
+    std::string name = toLower(text);
+    for (int i = 0; i < ENEMY_TYPE_COUNT; i++) {
+        if (name == toLower(CEnemyPool::getTypeInfo(static_cast<EnemyType>(i)).name)) {
+            type = static_cast<uint32_t>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// METODOS PRIVADOS
+bool CLevelFile::adoptStorage(const std::string& path) {
+    const LevelFileHeader* candidate = reinterpret_cast<const LevelFileHeader*>(storage.data());
+
+    if (std::memcmp(candidate->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "CLevelFile: " << path << " no es un nivel valido" << std::endl;
+        return false;
+    }
+    if (candidate->version != FORMAT_VERSION) {
+        std::cerr << "CLevelFile: Version " << candidate->version << " no soportada (se esperaba "
+                  << FORMAT_VERSION << ")" << std::endl;
+        return false;
+    }
+
+    // Rangos: con eso cualquier acceso posterior queda dentro del buffer
+    bool valid = candidate->width > 0.0f && candidate->height > 0.0f &&
+        sectionFits(candidate->spawnOffset, candidate->spawnCount, sizeof(LevelFileSpawn), byteSize) &&
+        sectionFits(candidate->platformOffset, candidate->platformCount, sizeof(LevelFilePlatform), byteSize) &&
+        sectionFits(candidate->obstacleOffset, candidate->obstacleCount, sizeof(LevelFileObstacle), byteSize) &&
+        sectionFits(candidate->layerOffset, candidate->layerCount, sizeof(LevelFileLayer), byteSize) &&
+        candidate->stringSize > 0 &&
+        static_cast<uint64_t>(candidate->stringOffset) + candidate->stringSize <= byteSize;
+
+    // La tabla de cadenas debe acabar en '\0' para que ningún offset lea fuera
+    if (valid) {
+        const char* bytes = reinterpret_cast<const char*>(storage.data());
+        valid = bytes[candidate->stringOffset + candidate->stringSize - 1] == '\0';
+    }
+
+    if (!valid) {
+        std::cerr << "CLevelFile: Secciones fuera de rango en " << path << std::endl;
+        return false;
+    }
+
+    // Un spawn con oleada o disparos a 0 contaría enemigos que nunca salen (el nivel no se completaría)
+    const LevelFileSpawn* spawns = reinterpret_cast<const LevelFileSpawn*>(sectionData(candidate->spawnOffset));
+    for (uint32_t i = 0; i < candidate->spawnCount; i++) {
+        if (!isValidSpawn(spawns[i])) {
+            std::cerr << "CLevelFile: Spawn " << i << " invalido en " << path
+                      << " (oleada y disparos >= 1, tiempos finitos y no negativos)" << std::endl;
+            return false;
+        }
+    }
+
+    header = candidate;
+    return true;
+}
+
+const char* CLevelFile::sectionData(uint32_t offset) const {
+    return reinterpret_cast<const char*>(storage.data()) + offset;
+}
@@ -0,0 +1,121 @@
+#ifndef CLEVELFILE_HPP
+#define CLEVELFILE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ===============================================
+// Registros del formato binario de nivel (.cvl)
+// ===============================================
+// Todos son POD de 4 bytes de alineación y se leen tal cual del archivo
+// (little endian, como x86 y ARM). Los offsets son bytes desde el inicio.
+struct LevelFileHeader {
+    char magic[4];              // "CVLV"
+    uint16_t version;
+    uint16_t flags;             // Reservado (0)
+    float width;                // Límites del nivel en píxeles
+    float height;
+    uint32_t nameOffset;        // Nombre en la tabla de cadenas
+    uint32_t spawnOffset;
+    uint32_t spawnCount;
+    uint32_t platformOffset;
+    uint32_t platformCount;
+    uint32_t obstacleOffset;
+    uint32_t obstacleCount;
+    uint32_t layerOffset;
+    uint32_t layerCount;
+    uint32_t stringOffset;      // Tabla de cadenas terminadas en '\0'
+    uint32_t stringSize;
+};
+
+struct LevelFileSpawn {
+    float x;
+    float y;
+    float spawnTime;            // Segundos (>= 0)
+    uint32_t enemyType;         // Índice de EnemyType
+    float interval;             // Segundos entre disparos (> 0 si firings > 1)
+    uint16_t waveSize;          // Enemigos por disparo (>= 1)
+    uint16_t firings;           // Disparos en total (>= 1)
+};
+
+struct LevelFilePlatform {
+    float x;
+    float y;
+    float width;
+    float height;
+    uint32_t color;             // 0xRRGGBBAA
+};
+
+struct LevelFileObstacle {
+    float x;
+    float y;
+    float width;
+    float height;
+};
+
+struct LevelFileLayer {
+    uint32_t pathOffset;        // Ruta de la textura de fondo en la tabla de cadenas
+};
+
+// ===============================================
+// Archivo de nivel: binario (.cvl) o texto
+// ===============================================
+// La forma binaria se lee de una vez a un buffer alineado y se valida solo la
+// cabecera y los rangos de cada sección: los registros se usan directamente
+// desde el buffer, sin recorrer campo a campo (el mismo layout sirve para
+// mapear el archivo en memoria). La forma de texto es la fuente editable:
+//   # comentario
+//   name Nivel 1
+//   size 800 600
+//   layer assets/layer_1.png                 (de atrás hacia delante)
+//   platform <x> <y> <ancho> <alto> [color]  (nombre o #RRGGBB[AA])
+//   obstacle <x> <y> <ancho> <alto>
+//   spawn <tipo> <x> <y> [segundos] [oleada <n>] [cada <segundos> <disparos>]
+//                                            (murcielago, esqueleto, zombie)
+// loadText() la empaqueta en memoria con el mismo formato que el binario.
+class CLevelFile {
+public:
+    static const uint16_t FORMAT_VERSION = 2;
+    static const char* const BINARY_EXTENSION;     // ".cvl"
+    static const char* const TEXT_EXTENSION;       // ".txt"
+
+private:
+    std::vector<uint32_t> storage;                 // Imagen del archivo (uint32_t: alineada a 4)
+    size_t byteSize;
+    const LevelFileHeader* header;                 // nullptr si no hay nada cargado
+
+public:
+    CLevelFile();
+
+    // Carga y guardado
+    bool load(const std::string& path);            // Binario o texto según la extensión
+    bool loadBinary(const std::string& path);
+    bool loadText(const std::string& path);
+    bool saveBinary(const std::string& path) const;
+    bool isLoaded() const;
+
+    // Acceso directo a los registros (punteros al buffer, válidos mientras viva el objeto)
+    float getWidth() const;
+    float getHeight() const;
+    const char* getName() const;
+    uint32_t getSpawnCount() const;
+    const LevelFileSpawn* getSpawns() const;
+    uint32_t getPlatformCount() const;
+    const LevelFilePlatform* getPlatforms() const;
+    uint32_t getObstacleCount() const;
+    const LevelFileObstacle* getObstacles() const;
+    uint32_t getLayerCount() const;
+    const LevelFileLayer* getLayers() const;
+    const char* getString(uint32_t offset) const;  // "" si el offset no es válido
+
+    // Utilidades del formato de texto
+    static bool parseColor(const std::string& text, uint32_t& rgba);
+    static bool parseEnemyType(const std::string& text, uint32_t& type);
+
+private:
+    bool adoptStorage(const std::string& path);    // Valida cabecera, secciones y spawns de storage
+    const char* sectionData(uint32_t offset) const;
+};
+
+#endif // CLEVELFILE_HPP
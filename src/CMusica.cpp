@@ -1,4 +1,5 @@
 #include "CMusica.hpp"
+#include "CTraceWriter.hpp"
 #include <iostream>
 #include <algorithm>
 
@@ -235,6 +236,8 @@ bool CMusica::isLooping() const {
 
 // UPDATE
 void CMusica::update(float deltaTime) {
+    TRACE_SCOPE("CMusica::update");
+    
     // Actualizar sistema de fade
     if (audioState == AudioState::FADING_IN || audioState == AudioState::FADING_OUT || 
         audioState == AudioState::TRANSITIONING) {
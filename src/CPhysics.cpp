@@ -1,14 +1,22 @@
 #include "CPhysics.hpp"
+#include "CTraceWriter.hpp"
 #include <iostream>
 #include <cmath>
 
 // Constructor
-CPhysics::CPhysics() {
+CPhysics::CPhysics() 
+    : fixedStepEnabled(true), fixedTimeStep(1.0f / DEFAULT_STEP_RATE),
+      maxSubSteps(DEFAULT_MAX_SUBSTEPS), accumulator(0.0f),
+      interpolationAlpha(1.0f), lastSubStepCount(0) {
     
     // Crear mundo con gravedad corregida
     b2Vec2 gravity(GRAVITY_X, GRAVITY_Y);
     world = std::make_unique<b2World>(gravity);
     
+    // Las fuerzas se limpian al final de update() para que una fuerza aplicada
+    // en el frame actue durante todos los subpasos de ese frame
+    world->SetAutoClearForces(false);
+    
     // Configurar listener de contactos
     contactListener = std::make_unique<PhysicsContactListener>();
     world->SetContactListener(contactListener.get());
@@ -21,10 +29,37 @@ CPhysics::~CPhysics() {
 
 // GESTION DEL MUNDO FISICO
 void CPhysics::update(float deltaTime) {
+    TRACE_SCOPE("CPhysics::update");
+    
     if (!world) return;
     
-    // Simular un paso del mundo fisico
-    world->Step(deltaTime, VELOCITY_ITERATIONS, POSITION_ITERATIONS);
+    if (!fixedStepEnabled) {
+        // Modo variable: un paso por frame con el deltaTime recibido
+        stepWorld(deltaTime);
+        lastSubStepCount = 1;
+        interpolationAlpha = 1.0f;
+    } else {
+        // Modo fijo: consumir el tiempo acumulado en pasos de duracion constante
+        accumulator += deltaTime;
+        
+        int steps = 0;
+        while (accumulator >= fixedTimeStep && steps < maxSubSteps) {
+            stepWorld(fixedTimeStep);
+            accumulator -= fixedTimeStep;
+            steps++;
+        }
+        
+        // Si se alcanzo el limite de subpasos, descartar el tiempo sobrante
+        if (accumulator >= fixedTimeStep) {
+            accumulator = std::fmod(accumulator, fixedTimeStep);
+        }
+        
+        lastSubStepCount = steps;
+        interpolationAlpha = accumulator / fixedTimeStep;
+    }
+    
+    // Las fuerzas del frame ya se aplicaron (o se descartan si no hubo pasos)
+    world->ClearForces();
     
     // Actualizar informacion de contactos
     if (contactListener) {
@@ -38,9 +73,69 @@ void CPhysics::setGravity(float x, float y) {
     }
 }
 
+// CONFIGURACION DEL PASO FIJO
+void CPhysics::setFixedTimestep(float stepRate, int maxSubSteps) {
+    if (stepRate <= 0.0f || maxSubSteps <= 0) {
+        std::cerr << "Error: Configuracion de paso fijo invalida (" << stepRate 
+                  << " Hz, " << maxSubSteps << " subpasos)" << std::endl;
+        return;
+    }
+    
+    fixedTimeStep = 1.0f / stepRate;
+    this->maxSubSteps = maxSubSteps;
+    accumulator = 0.0f;
+}
+
+void CPhysics::setFixedStepEnabled(bool enabled) {
+    fixedStepEnabled = enabled;
+    accumulator = 0.0f;
+    interpolationAlpha = 1.0f;
+}
+
+bool CPhysics::isFixedStepEnabled() const {
+    return fixedStepEnabled;
+}
+
+float CPhysics::getFixedTimeStep() const {
+    return fixedTimeStep;
+}
+
+int CPhysics::getMaxSubSteps() const {
+    return maxSubSteps;
+}
+
+float CPhysics::getInterpolationAlpha() const {
+    return interpolationAlpha;
+}
+
+int CPhysics::getLastSubStepCount() const {
+    return lastSubStepCount;
+}
+
+sf::Vector2f CPhysics::getInterpolatedPosition(BodyHandle handle) const {
+    const PhysicsBody* physicsBody = bodies.get(handle);
+    if (!physicsBody || !physicsBody->body) {
+        return sf::Vector2f(0.0f, 0.0f);
+    }
+    
+    const b2Vec2& previous = physicsBody->previousPosition;
+    const b2Vec2& current = physicsBody->body->GetPosition();
+    
+    b2Vec2 blended(previous.x + (current.x - previous.x) * interpolationAlpha,
+                   previous.y + (current.y - previous.y) * interpolationAlpha);
+    return metersToPixels(blended);
+}
+
+void CPhysics::resetInterpolation(BodyHandle handle) {
+    PhysicsBody* physicsBody = bodies.get(handle);
+    if (physicsBody && physicsBody->body) {
+        physicsBody->previousPosition = physicsBody->body->GetPosition();
+    }
+}
+
 // CREACION DE CUERPOS
-b2Body* CPhysics::createPlayerBody(float x, float y, void* userData) {
-    if (!world) return nullptr;
+BodyHandle CPhysics::createPlayerBody(float x, float y, void* userData) {
+    if (!world) return BodyHandle();
     
     // Definicion del cuerpo
     b2BodyDef bodyDef;
@@ -69,13 +164,11 @@ b2Body* CPhysics::createPlayerBody(float x, float y, void* userData) {
     body->CreateFixture(&fixtureDef);
     
     // Almacenar informacion del cuerpo
-    bodies.emplace(userData, PhysicsBody(body, BodyType::PLAYER, userData));
-    
-    return body;
+    return registerBody(body, BodyType::PLAYER, userData);
 }
 
-b2Body* CPhysics::createEnemyBody(float x, float y, void* userData) {
-    if (!world) return nullptr;
+BodyHandle CPhysics::createEnemyBody(float x, float y, void* userData) {
+    if (!world) return BodyHandle();
     
     // Definicion del cuerpo
     b2BodyDef bodyDef;
@@ -104,14 +197,35 @@ b2Body* CPhysics::createEnemyBody(float x, float y, void* userData) {
     body->CreateFixture(&fixtureDef);
     
     // Almacenar informacion del cuerpo
-    bodies.emplace(userData, PhysicsBody(body, BodyType::ENEMY, userData));
+    return registerBody(body, BodyType::ENEMY, userData);
+}
+
+bool CPhysics::recycleEnemyBody(BodyHandle handle, float x, float y, void* userData) {
+    PhysicsBody* physicsBody = bodies.get(handle);
+    if (!physicsBody || !physicsBody->body || physicsBody->type != BodyType::ENEMY) {
+        return false;
+    }
+    
+    // Mismo estado que uno recien creado, sin pasar por el allocator de Box2D
+    b2Body* body = physicsBody->body;
+    body->SetTransform(b2Vec2(pixelsToMeters(x), pixelsToMeters(y)), 0.0f);
+    body->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
+    body->SetAngularVelocity(0.0f);
     
-    return body;
+    for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+        fixture->GetUserData().pointer = reinterpret_cast<uintptr_t>(userData);
+    }
+    physicsBody->userData = userData;
+    
+    body->SetEnabled(true);
+    body->SetAwake(true);
+    physicsBody->previousPosition = body->GetPosition();
+    return true;
 }
 
 // Metodo createPlatform corregido
-b2Body* CPhysics::createPlatform(float x, float y, float width, float height) {
-    if (!world) return nullptr;
+BodyHandle CPhysics::createPlatform(float x, float y, float width, float height) {
+    if (!world) return BodyHandle();
 
     // PASO 1: CALCULAR CENTRO EXACTO DE LA PLATAFORMA VISUAL
     float centerX = x + (width / 2.0f);
@@ -146,13 +260,45 @@ b2Body* CPhysics::createPlatform(float x, float y, float width, float height) {
     body->CreateFixture(&fixtureDef);
 
     // Almacenar informacion del cuerpo
-    bodies.emplace(body, PhysicsBody(body, BodyType::PLATFORM, nullptr));
+    return registerBody(body, BodyType::PLATFORM, nullptr);
+}
+
+BodyHandle CPhysics::createPlatformLoop(const std::vector<sf::Vector2f>& outline) {
+    if (!world || outline.size() < 3) return BodyHandle();
+    
+    // Cuerpo estatico en el origen: los vertices van en coordenadas del mundo
+    b2BodyDef bodyDef;
+    bodyDef.type = b2_staticBody;
+    bodyDef.position.Set(0.0f, 0.0f);
+    
+    b2Body* body = world->CreateBody(&bodyDef);
+    
+    // Cadena cerrada de un solo lado: las normales apuntan hacia fuera del solido
+    std::vector<b2Vec2> vertices;
+    vertices.reserve(outline.size());
+    for (const sf::Vector2f& point : outline) {
+        vertices.push_back(sfmlVecToB2(point));
+    }
+    
+    b2ChainShape shape;
+    shape.CreateLoop(vertices.data(), static_cast<int32>(vertices.size()));
+    
+    // Mismas propiedades que createPlatform()
+    b2FixtureDef fixtureDef;
+    fixtureDef.shape = &shape;
+    fixtureDef.density = 0.0f;
+    fixtureDef.friction = 0.7f;
+    fixtureDef.restitution = 0.0f;
+    fixtureDef.filter.categoryBits = CATEGORY_PLATFORM;
+    fixtureDef.filter.maskBits = CATEGORY_PLAYER | CATEGORY_ENEMY;
+    
+    body->CreateFixture(&fixtureDef);
     
-    return body;
+    return registerBody(body, BodyType::PLATFORM, nullptr);
 }
 
-b2Body* CPhysics::createWall(float x, float y, float width, float height) {
-    if (!world) return nullptr;
+BodyHandle CPhysics::createWall(float x, float y, float width, float height) {
+    if (!world) return BodyHandle();
         
     float centerX = x + width/2.0f;
     float centerY = y + height/2.0f;
@@ -182,43 +328,43 @@ b2Body* CPhysics::createWall(float x, float y, float width, float height) {
     body->CreateFixture(&fixtureDef);
     
     // Almacenar informacion del cuerpo
-    bodies.emplace(body, PhysicsBody(body, BodyType::WALL, nullptr));
-    
-    return body;
+    return registerBody(body, BodyType::WALL, nullptr);
 }
 
 // GESTION DE CUERPOS
-void CPhysics::destroyBody(void* userData) {
-    auto it = bodies.find(userData);
-    if (it != bodies.end() && world) {
-        world->DestroyBody(it->second.body);
-        bodies.erase(it);
+void CPhysics::destroyBody(BodyHandle handle) {
+    PhysicsBody* physicsBody = bodies.get(handle);
+    if (physicsBody && world) {
+        world->DestroyBody(physicsBody->body);
+        bodies.erase(handle);
     }
 }
 
-b2Body* CPhysics::getBody(void* userData) {
-    auto it = bodies.find(userData);
-    return (it != bodies.end()) ? it->second.body : nullptr;
+b2Body* CPhysics::getBody(BodyHandle handle) const {
+    const PhysicsBody* physicsBody = bodies.get(handle);
+    return physicsBody ? physicsBody->body : nullptr;
+}
+
+bool CPhysics::isValid(BodyHandle handle) const {
+    return bodies.contains(handle);
 }
 
 void CPhysics::destroyBody(b2Body* body) {
     if (!body || !world) return;
     
-    // Buscar en el mapa y eliminar
-    for (auto it = bodies.begin(); it != bodies.end(); ++it) {
-        if (it->second.body == body) {
-            bodies.erase(it);
-            break;
-        }
+    // Cada cuerpo guarda su propio handle: no hace falta buscarlo
+    BodyHandle handle = BodyHandle::unpack(body->GetUserData().pointer);
+    PhysicsBody* physicsBody = bodies.get(handle);
+    if (physicsBody && physicsBody->body == body) {
+        bodies.erase(handle);
     }
     
     // Destruir el cuerpo
     world->DestroyBody(body);
 }
 
-PhysicsBody* CPhysics::getPhysicsBody(void* userData) {
-    auto it = bodies.find(userData);
-    return (it != bodies.end()) ? &it->second : nullptr;
+PhysicsBody* CPhysics::getPhysicsBody(BodyHandle handle) {
+    return bodies.get(handle);
 }
 
 // UTILIDADES DE CONVERSION
@@ -247,22 +393,22 @@ sf::Vector2f CPhysics::metersToPixels(const b2Vec2& meters) {
 }
 
 // CONTROL DE MOVIMIENTO
-void CPhysics::setBodyVelocity(void* userData, float x, float y) {
-    b2Body* body = getBody(userData);
+void CPhysics::setBodyVelocity(BodyHandle handle, float x, float y) {
+    b2Body* body = getBody(handle);
     if (body) {
         body->SetLinearVelocity(b2Vec2(x, y));
     }
 }
 
-void CPhysics::applyForce(void* userData, float x, float y) {
-    b2Body* body = getBody(userData);
+void CPhysics::applyForce(BodyHandle handle, float x, float y) {
+    b2Body* body = getBody(handle);
     if (body) {
         body->ApplyForceToCenter(b2Vec2(x, y), true);
     }
 }
 
-void CPhysics::applyImpulse(void* userData, float x, float y) {
-    b2Body* body = getBody(userData);
+void CPhysics::applyImpulse(BodyHandle handle, float x, float y) {
+    b2Body* body = getBody(handle);
     if (body) {
         body->ApplyLinearImpulseToCenter(b2Vec2(x, y), true);
     }
@@ -291,8 +437,8 @@ void CPhysics::debugPrint() const {
     
     int players = 0, enemies = 0, platforms = 0, walls = 0;
     
-    for (const auto& pair : bodies) {
-        switch (pair.second.type) {
+    for (const PhysicsBody& physicsBody : bodies) {
+        switch (physicsBody.type) {
             case BodyType::PLAYER: players++; break;
             case BodyType::ENEMY: enemies++; break;
             case BodyType::PLATFORM: platforms++; break;
@@ -309,13 +455,47 @@ void CPhysics::debugPrint() const {
         b2Vec2 gravity = world->GetGravity();
         std::cout << "  Gravedad: (" << gravity.x << ", " << gravity.y << ")" << std::endl;
     }
+    
+    if (fixedStepEnabled) {
+        std::cout << "  Paso fijo: " << (1.0f / fixedTimeStep) << " Hz (max " << maxSubSteps 
+                  << " subpasos, ultimo frame: " << lastSubStepCount << ", alpha: " << interpolationAlpha << ")" << std::endl;
+    } else {
+        std::cout << "  Paso variable" << std::endl;
+    }
 }
 
 int CPhysics::getBodyCount() const {
     return static_cast<int>(bodies.size());
 }
 
+int CPhysics::getProxyCount() const {
+    return world ? world->GetProxyCount() : 0;
+}
+
 // METODOS AUXILIARES PRIVADOS
+void CPhysics::stepWorld(float timeStep) {
+    storePreviousPositions();
+    world->Step(timeStep, VELOCITY_ITERATIONS, POSITION_ITERATIONS);
+}
+
+void CPhysics::storePreviousPositions() {
+    // Solo los cuerpos dinamicos se mueven; los estaticos no necesitan interpolacion
+    for (PhysicsBody& physicsBody : bodies) {
+        if (physicsBody.body && physicsBody.body->GetType() == b2_dynamicBody) {
+            physicsBody.previousPosition = physicsBody.body->GetPosition();
+        }
+    }
+}
+
+BodyHandle CPhysics::registerBody(b2Body* body, BodyType type, void* userData) {
+    BodyHandle handle = bodies.emplace(body, type, userData);
+    
+    // Guardar el handle en el propio cuerpo para destroyBody(b2Body*)
+    body->GetUserData().pointer = static_cast<uintptr_t>(handle.pack());
+    
+    return handle;
+}
+
 b2BodyDef CPhysics::createBodyDef(float x, float y, b2BodyType type) {
     b2BodyDef bodyDef;
     bodyDef.type = type;
@@ -401,17 +581,18 @@ void PhysicsContactListener::updateGroundContacts() {
 }
 
 void CPhysics::destroyAllPlatforms() {    
-    std::vector<b2Body*> platformsToDestroy;
+    std::vector<BodyHandle> platformsToDestroy;
     
-    // Recopilar todas las plataformas
-    for (auto& pair : bodies) {
-        if (pair.second.type == BodyType::PLATFORM) {
-            platformsToDestroy.push_back(pair.second.body);
+    // Recopilar todas las plataformas (no se puede borrar mientras se itera)
+    for (size_t i = 0; i < bodies.size(); i++) {
+        BodyHandle handle = bodies.handleAt(i);
+        if (bodies.get(handle)->type == BodyType::PLATFORM) {
+            platformsToDestroy.push_back(handle);
         }
     }
     
     // Destruir cada plataforma
-    for (b2Body* platform : platformsToDestroy) {
+    for (BodyHandle platform : platformsToDestroy) {
         destroyBody(platform);
     }
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <SFML/Graphics.hpp>
 #include <memory>
 #include <unordered_map>
+#include <vector>
+#include "CSlotMap.hpp"
 
 // Categorías de colisión
 enum CollisionCategory {
@@ -27,11 +29,15 @@ struct PhysicsBody {
     b2Body* body;
     BodyType type;
     void* userData;  // Puntero al objeto del juego (CPlayer*, CEnemy*, etc.)
+    b2Vec2 previousPosition;  // Posición antes del último paso fijo (para interpolar)
     
     PhysicsBody(b2Body* b, BodyType t, void* data = nullptr) 
-        : body(b), type(t), userData(data) {}
+        : body(b), type(t), userData(data), previousPosition(b ? b->GetPosition() : b2Vec2(0.0f, 0.0f)) {}
 };
 
+// Referencia a un cuerpo de CPhysics: búsqueda O(1) y detecta cuerpos ya destruidos
+using BodyHandle = CSlotMap<PhysicsBody>::Handle;
+
 // ===============================================
 // NUEVO: ContactListener para detectar colisiones
 // ===============================================
@@ -53,7 +59,7 @@ private:
 class CPhysics {
 private:
     std::unique_ptr<b2World> world;
-    std::unordered_map<void*, PhysicsBody> bodies;
+    CSlotMap<PhysicsBody> bodies;                  // Todos los cuerpos, contiguos en memoria
     
     // ===============================================
     // NUEVO: ContactListener para detectar colisiones
@@ -73,6 +79,19 @@ private:
     static constexpr int32 VELOCITY_ITERATIONS = 8;  // ← CORREGIDO: De 6 a 8 para más precisión
     static constexpr int32 POSITION_ITERATIONS = 3;  // ← CORREGIDO: De 2 a 3 para mejor estabilidad
     
+    // ===============================================
+    // NUEVO: Paso fijo con acumulador
+    // ===============================================
+    static constexpr float DEFAULT_STEP_RATE = 60.0f;   // Pasos de simulación por segundo
+    static constexpr int DEFAULT_MAX_SUBSTEPS = 5;      // Límite de pasos por frame (evita la espiral de la muerte)
+    
+    bool fixedStepEnabled;
+    float fixedTimeStep;          // Duración de un paso (1 / stepRate)
+    int maxSubSteps;
+    float accumulator;            // Tiempo real pendiente de simular
+    float interpolationAlpha;     // Fracción del paso actual [0, 1) para renderizar
+    int lastSubStepCount;         // Pasos ejecutados en el último update()
+    
 public:
     // Constructor y destructor
     CPhysics();
@@ -82,18 +101,36 @@ public:
     void update(float deltaTime);
     void setGravity(float x, float y);
     
+    // ===============================================
+    // NUEVO: Configuración del paso fijo
+    // ===============================================
+    void setFixedTimestep(float stepRate, int maxSubSteps);
+    void setFixedStepEnabled(bool enabled);
+    bool isFixedStepEnabled() const;
+    float getFixedTimeStep() const;
+    int getMaxSubSteps() const;
+    float getInterpolationAlpha() const;
+    int getLastSubStepCount() const;
+    
+    // Posición interpolada entre el estado anterior y el actual (en píxeles)
+    sf::Vector2f getInterpolatedPosition(BodyHandle handle) const;
+    void resetInterpolation(BodyHandle handle);  // Llamar tras teletransportar un cuerpo
+    
     // Creación de cuerpos
-    b2Body* createPlayerBody(float x, float y, void* userData = nullptr);
-    b2Body* createEnemyBody(float x, float y, void* userData = nullptr);
-    b2Body* createPlatform(float x, float y, float width, float height);
-    b2Body* createWall(float x, float y, float width, float height);
+    BodyHandle createPlayerBody(float x, float y, void* userData = nullptr);
+    BodyHandle createEnemyBody(float x, float y, void* userData = nullptr);
+    bool recycleEnemyBody(BodyHandle handle, float x, float y, void* userData);  // Reactiva uno deshabilitado en (x, y)
+    BodyHandle createPlatform(float x, float y, float width, float height);
+    BodyHandle createPlatformLoop(const std::vector<sf::Vector2f>& outline);  // Contorno en píxeles (horario en pantalla)
+    BodyHandle createWall(float x, float y, float width, float height);
     
     // Gestión de cuerpos
-    void destroyBody(void* userData);
-    void destroyBody(b2Body* body); 
-    b2Body* getBody(void* userData);
+    void destroyBody(BodyHandle handle);
+    void destroyBody(b2Body* body);              // O(1): el handle va en el userData del cuerpo
+    b2Body* getBody(BodyHandle handle) const;    // nullptr si el cuerpo ya no existe
+    bool isValid(BodyHandle handle) const;
     void destroyAllPlatforms(); 
-    PhysicsBody* getPhysicsBody(void* userData);
+    PhysicsBody* getPhysicsBody(BodyHandle handle);
     
     // Utilidades de conversión
     static sf::Vector2f b2VecToSFML(const b2Vec2& vec);
@@ -104,9 +141,9 @@ public:
     static sf::Vector2f metersToPixels(const b2Vec2& meters);
     
     // Control de movimiento
-    void setBodyVelocity(void* userData, float x, float y);
-    void applyForce(void* userData, float x, float y);
-    void applyImpulse(void* userData, float x, float y);
+    void setBodyVelocity(BodyHandle handle, float x, float y);
+    void applyForce(BodyHandle handle, float x, float y);
+    void applyImpulse(BodyHandle handle, float x, float y);
     
     // Verificaciones mejoradas
     bool isBodyOnGround(void* userData);
@@ -120,12 +157,20 @@ public:
     // Debug
     void debugPrint() const;
     int getBodyCount() const;
+    int getProxyCount() const;                   // Proxies en el broadphase (uno por caja, uno por arista de cadena)
     
 private:
     // Métodos auxiliares
     b2BodyDef createBodyDef(float x, float y, b2BodyType type);
     b2FixtureDef createFixtureDef(b2Shape* shape, float density, float friction, float restitution, uint16 category, uint16 mask);
     
+    // Paso fijo
+    void stepWorld(float timeStep);
+    void storePreviousPositions();
+    
+    // Registro de cuerpos
+    BodyHandle registerBody(b2Body* body, BodyType type, void* userData);
+    
     // Cleanup
     void cleanup();
 };
@@ -0,0 +1,273 @@
+#include "CPlatformMerger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+
+namespace {
+    float rightOf(const sf::FloatRect& rect) { return rect.left + rect.width; }
+    float bottomOf(const sf::FloatRect& rect) { return rect.top + rect.height; }
+
+    bool nearlyEqual(float a, float b) {
+        return std::abs(a - b) <= CPlatformMerger::EPSILON;
+    }
+
+    // Raíz del grupo con compresión de caminos
+    size_t findRoot(std::vector<size_t>& parents, size_t index) {
+        while (parents[index] != index) {
+            parents[index] = parents[parents[index]];
+            index = parents[index];
+        }
+        return index;
+    }
+
+    // Valores ordenados sin repetir (los que distan menos de EPSILON se quedan con el primero)
+    std::vector<float> uniqueCoordinates(std::vector<float> values) {
+        std::sort(values.begin(), values.end());
+        std::vector<float> unique;
+        for (float value : values) {
+            if (unique.empty() || value - unique.back() > CPlatformMerger::EPSILON) {
+                unique.push_back(value);
+            }
+        }
+        return unique;
+    }
+
+    int coordinateIndex(const std::vector<float>& coordinates, float value) {
+        auto it = std::lower_bound(coordinates.begin(), coordinates.end(), value - CPlatformMerger::EPSILON);
+        return static_cast<int>(it - coordinates.begin());
+    }
+}
+
+// FUSION
+PlatformMergeStats CPlatformMerger::merge(const std::vector<sf::FloatRect>& platforms, std::vector<PlatformSolid>& out) {
+    PlatformMergeStats stats{platforms.size(), 0, platforms.size(), 0};
+    out.clear();
+
+    std::vector<sf::FloatRect> rects;
+    rects.reserve(platforms.size());
+    for (const sf::FloatRect& platform : platforms) {
+        if (platform.width > 0.0f && platform.height > 0.0f) {
+            rects.push_back(platform);
+        }
+    }
+
+    // Cajas: filas y columnas hasta que no se pueda unir nada más
+    size_t previous;
+    do {
+        previous = rects.size();
+        mergeRows(rects);
+        mergeColumns(rects);
+    } while (rects.size() < previous);
+
+    // Grupos de cajas que se tocan (barrido ordenado por el borde izquierdo)
+    std::sort(rects.begin(), rects.end(),
+        [](const sf::FloatRect& a, const sf::FloatRect& b) { return a.left < b.left; });
+
+    std::vector<size_t> parents(rects.size());
+    std::iota(parents.begin(), parents.end(), 0);
+    for (size_t i = 0; i < rects.size(); i++) {
+        for (size_t j = i + 1; j < rects.size() && rects[j].left <= rightOf(rects[i]) + EPSILON; j++) {
+            if (touches(rects[i], rects[j])) {
+                parents[findRoot(parents, j)] = findRoot(parents, i);
+            }
+        }
+    }
+
+    std::unordered_map<size_t, std::vector<sf::FloatRect>> groups;
+    std::vector<size_t> groupOrder;              // Orden de aparición: resultado estable entre ejecuciones
+    for (size_t i = 0; i < rects.size(); i++) {
+        size_t root = findRoot(parents, i);
+        if (groups.find(root) == groups.end()) {
+            groupOrder.push_back(root);
+        }
+        groups[root].push_back(rects[i]);
+    }
+
+    // Un grupo pasa a contorno si se puede y no añade proxies; si no, se queda en cajas
+    std::vector<PlatformSolid> outlines;
+    for (size_t root : groupOrder) {
+        const std::vector<sf::FloatRect>& group = groups[root];
+
+        outlines.clear();
+        if (group.size() > 1 && traceOutlines(group, outlines)) {
+            size_t outlineProxies = 0;
+            for (const PlatformSolid& solid : outlines) {
+                outlineProxies += solid.getProxyCount();
+            }
+            if (outlineProxies <= group.size()) {
+                out.insert(out.end(), outlines.begin(), outlines.end());
+                continue;
+            }
+        }
+
+        for (const sf::FloatRect& rect : group) {
+            out.push_back(PlatformSolid{rect, {}});
+        }
+    }
+
+    stats.solids = out.size();
+    for (const PlatformSolid& solid : out) {
+        stats.proxiesAfter += solid.getProxyCount();
+    }
+    return stats;
+}
+
+// PRIVADOS
+void CPlatformMerger::mergeRows(std::vector<sf::FloatRect>& rects) {
+    if (rects.size() < 2) return;
+
+    std::sort(rects.begin(), rects.end(), [](const sf::FloatRect& a, const sf::FloatRect& b) {
+        if (a.top != b.top) return a.top < b.top;
+        if (bottomOf(a) != bottomOf(b)) return bottomOf(a) < bottomOf(b);
+        return a.left < b.left;
+    });
+
+    std::vector<sf::FloatRect> merged;
+    sf::FloatRect current = rects.front();
+    for (size_t i = 1; i < rects.size(); i++) {
+        const sf::FloatRect& next = rects[i];
+        if (nearlyEqual(next.top, current.top) && nearlyEqual(bottomOf(next), bottomOf(current)) &&
+            next.left <= rightOf(current) + EPSILON) {
+            current.width = std::max(rightOf(current), rightOf(next)) - current.left;
+        } else {
+            merged.push_back(current);
+            current = next;
+        }
+    }
+    merged.push_back(current);
+    rects.swap(merged);
+}
+
+void CPlatformMerger::mergeColumns(std::vector<sf::FloatRect>& rects) {
+    if (rects.size() < 2) return;
+
+    std::sort(rects.begin(), rects.end(), [](const sf::FloatRect& a, const sf::FloatRect& b) {
+        if (a.left != b.left) return a.left < b.left;
+        if (rightOf(a) != rightOf(b)) return rightOf(a) < rightOf(b);
+        return a.top < b.top;
+    });
+
+    std::vector<sf::FloatRect> merged;
+    sf::FloatRect current = rects.front();
+    for (size_t i = 1; i < rects.size(); i++) {
+        const sf::FloatRect& next = rects[i];
+        if (nearlyEqual(next.left, current.left) && nearlyEqual(rightOf(next), rightOf(current)) &&
+            next.top <= bottomOf(current) + EPSILON) {
+            current.height = std::max(bottomOf(current), bottomOf(next)) - current.top;
+        } else {
+            merged.push_back(current);
+            current = next;
+        }
+    }
+    merged.push_back(current);
+    rects.swap(merged);
+}
+
+bool CPlatformMerger::touches(const sf::FloatRect& a, const sf::FloatRect& b) {
+    return a.left <= rightOf(b) + EPSILON && b.left <= rightOf(a) + EPSILON &&
+           a.top <= bottomOf(b) + EPSILON && b.top <= bottomOf(a) + EPSILON;
+}
+
+bool CPlatformMerger::traceOutlines(const std::vector<sf::FloatRect>& group, std::vector<PlatformSolid>& out) {
+    // Rejilla comprimida: una columna/fila por cada borde distinto del grupo
+    std::vector<float> xValues;
+    std::vector<float> yValues;
+    for (const sf::FloatRect& rect : group) {
+        xValues.push_back(rect.left);
+        xValues.push_back(rightOf(rect));
+        yValues.push_back(rect.top);
+        yValues.push_back(bottomOf(rect));
+    }
+    std::vector<float> xs = uniqueCoordinates(xValues);
+    std::vector<float> ys = uniqueCoordinates(yValues);
+
+    int columns = static_cast<int>(xs.size()) - 1;
+    int rows = static_cast<int>(ys.size()) - 1;
+    if (columns < 1 || rows < 1) return false;
+
+    std::vector<uint8_t> covered(static_cast<size_t>(columns) * rows, 0);
+    for (const sf::FloatRect& rect : group) {
+        int x0 = coordinateIndex(xs, rect.left);
+        int x1 = coordinateIndex(xs, rightOf(rect));
+        int y0 = coordinateIndex(ys, rect.top);
+        int y1 = coordinateIndex(ys, bottomOf(rect));
+        for (int y = y0; y < y1; y++) {
+            for (int x = x0; x < x1; x++) {
+                covered[static_cast<size_t>(y) * columns + x] = 1;
+            }
+        }
+    }
+
+    auto isCovered = [&](int x, int y) {
+        return x >= 0 && y >= 0 && x < columns && y < rows && covered[static_cast<size_t>(y) * columns + x];
+    };
+
+    // Aristas del borde entre celda cubierta y vacía, orientadas con el sólido a la izquierda en pantalla
+    // (horario con y hacia abajo): la normal de Box2D queda hacia fuera
+    int stride = columns + 1;
+    std::vector<std::pair<int, int>> edges;      // Vértice inicial, vértice final (y * stride + x)
+    std::unordered_map<int, size_t> outgoing;    // Vértice inicial -> arista
+    auto addEdge = [&](int fromX, int fromY, int toX, int toY) {
+        int from = fromY * stride + fromX;
+        if (outgoing.count(from)) return false;  // Contorno que se toca a sí mismo: no es un lazo simple
+        outgoing[from] = edges.size();
+        edges.emplace_back(from, toY * stride + toX);
+        return true;
+    };
+
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < columns; x++) {
+            if (!isCovered(x, y)) continue;
+            if (!isCovered(x, y - 1) && !addEdge(x, y, x + 1, y)) return false;
+            if (!isCovered(x + 1, y) && !addEdge(x + 1, y, x + 1, y + 1)) return false;
+            if (!isCovered(x, y + 1) && !addEdge(x + 1, y + 1, x, y + 1)) return false;
+            if (!isCovered(x - 1, y) && !addEdge(x, y + 1, x, y)) return false;
+        }
+    }
+
+    // Recorrer cada lazo y quedarse solo con las esquinas (out no se toca si algo falla)
+    std::vector<PlatformSolid> solids;
+    std::vector<uint8_t> visited(edges.size(), 0);
+    for (size_t start = 0; start < edges.size(); start++) {
+        if (visited[start]) continue;
+
+        std::vector<int> loop;
+        size_t edge = start;
+        while (!visited[edge]) {
+            visited[edge] = 1;
+            loop.push_back(edges[edge].first);
+            auto next = outgoing.find(edges[edge].second);
+            if (next == outgoing.end()) return false;
+            edge = next->second;
+        }
+        if (edge != start) return false;
+
+        PlatformSolid solid;
+        float minX = xs.back(), minY = ys.back(), maxX = xs.front(), maxY = ys.front();
+        for (size_t i = 0; i < loop.size(); i++) {
+            int previous = loop[(i + loop.size() - 1) % loop.size()];
+            int current = loop[i];
+            int following = loop[(i + 1) % loop.size()];
+
+            // Vértice en medio de un tramo recto: sobra
+            int inX = current % stride - previous % stride, inY = current / stride - previous / stride;
+            int outX = following % stride - current % stride, outY = following / stride - current / stride;
+            if ((inX == 0) == (outX == 0) && (inY == 0) == (outY == 0)) continue;
+
+            sf::Vector2f point(xs[current % stride], ys[current / stride]);
+            solid.outline.push_back(point);
+            minX = std::min(minX, point.x);
+            minY = std::min(minY, point.y);
+            maxX = std::max(maxX, point.x);
+            maxY = std::max(maxY, point.y);
+        }
+        if (solid.outline.size() < 4) return false;
+
+        solid.bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+        solids.push_back(std::move(solid));
+    }
+
+    out.swap(solids);
+    return true;
+}
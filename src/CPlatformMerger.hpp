@@ -0,0 +1,48 @@
+#ifndef CPLATFORMMERGER_HPP
+#define CPLATFORMMERGER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Sólido de colisión estático del nivel: una caja o un contorno cerrado
+struct PlatformSolid {
+    sf::FloatRect bounds;
+    std::vector<sf::Vector2f> outline;   // Vacío: caja = bounds. Si no, vértices en píxeles (horario en pantalla)
+
+    size_t getProxyCount() const { return outline.empty() ? 1 : outline.size(); }
+};
+
+// Resumen de una fusión (para el informe de carga)
+struct PlatformMergeStats {
+    size_t platforms;            // Rectángulos de entrada (un cuerpo y un proxy cada uno)
+    size_t solids;               // Cuerpos resultantes
+    size_t proxiesBefore;
+    size_t proxiesAfter;
+};
+
+// ===============================================
+// Fusión de plataformas estáticas
+// ===============================================
+// Se ejecuta al construir el layout. Primero une en una sola caja las
+// plataformas contiguas o solapadas que comparten borde superior e inferior
+// (filas de baldosas) o izquierdo y derecho (columnas). Las que aún se tocan
+// forman grupos cuyo contorno exterior (y el de sus huecos) se extrae sobre una
+// rejilla comprimida con las coordenadas de sus bordes y se convierte en una
+// cadena cerrada (b2ChainShape), sin costuras internas con las que tropezar.
+// Cada arista de una cadena es un proxy del broadphase, así que el contorno
+// solo se usa si no tiene más aristas que cajas el grupo; si no (o si el
+// contorno se toca a sí mismo en un vértice), el grupo se queda en cajas.
+class CPlatformMerger {
+public:
+    static constexpr float EPSILON = 0.5f;       // Píxeles: bordes a menos de esto se consideran iguales
+
+    static PlatformMergeStats merge(const std::vector<sf::FloatRect>& platforms, std::vector<PlatformSolid>& out);
+
+private:
+    static void mergeRows(std::vector<sf::FloatRect>& rects);
+    static void mergeColumns(std::vector<sf::FloatRect>& rects);
+    static bool touches(const sf::FloatRect& a, const sf::FloatRect& b);
+    static bool traceOutlines(const std::vector<sf::FloatRect>& group, std::vector<PlatformSolid>& out);
+};
+
+#endif // CPLATFORMMERGER_HPP
@@ -1,5 +1,6 @@
 #include "CPlayer.hpp"
 #include "CPhysics.hpp"
+#include "CEventBus.hpp"
 #include <iostream>
 
 // Constructor
@@ -76,6 +77,10 @@ b2Body* CPlayer::getPhysicsBody() const {
     return physicsBody;
 }
 
+BodyHandle CPlayer::getPhysicsHandle() const {
+    return physicsHandle;
+}
+
 sf::Vector2f CPlayer::getVelocity() const {
     if (!physicsEnabled || !physicsBody) {
         return sf::Vector2f(0.0f, 0.0f);
@@ -135,7 +140,8 @@ void CPlayer::initializePhysics(CPhysics* physics) {
     this->physics = physics;
     
     // Crear cuerpo fisico del jugador
-    physicsBody = this->physics->createPlayerBody(position.x, position.y, this);
+    physicsHandle = this->physics->createPlayerBody(position.x, position.y, this);
+    physicsBody = this->physics->getBody(physicsHandle);
     
     if (physicsBody) {
         physicsEnabled = true;
@@ -152,9 +158,8 @@ void CPlayer::initializePhysics(CPhysics* physics) {
 void CPlayer::syncPositionFromPhysics() {
     if (!physicsEnabled || !physicsBody) return;
     
-    // Obtener posicion del cuerpo fisico
-    b2Vec2 physicsPos = physicsBody->GetPosition();
-    sf::Vector2f newPos = CPhysics::metersToPixels(physicsPos);
+    // Posicion interpolada entre los dos ultimos pasos fijos de la simulacion
+    sf::Vector2f newPos = physics->getInterpolatedPosition(physicsHandle);
     
     // Actualizar posicion visual
     position = newPos;
@@ -175,6 +180,9 @@ void CPlayer::updatePhysicsPosition() {
     // Convertir posicion visual a fisicas
     b2Vec2 physicsPos = CPhysics::sfmlVecToB2(position);
     physicsBody->SetTransform(physicsPos, physicsBody->GetAngle());
+    
+    // Evitar que la interpolacion arrastre el sprite desde la posicion anterior
+    physics->resetInterpolation(physicsHandle);
 }
 
 // METODOS PARA CONFIGURAR SPRITES MANUALMENTE
@@ -242,7 +250,7 @@ void CPlayer::moveWithPhysics(float direction) {
     
     // Limitar velocidad horizontal maxima
     if (std::abs(velocity.x) < MAX_VELOCITY_X) {
-        physics->applyForce(this, force, 0.0f);
+        physics->applyForce(physicsHandle, force, 0.0f);
     }
     
     // Actualizar estado de animacion
@@ -259,7 +267,7 @@ void CPlayer::jump() {
     
     
     // Aplicar impulso hacia arriba
-    physics->applyImpulse(this, 0.0f, -jumpForce);
+    physics->applyImpulse(physicsHandle, 0.0f, -jumpForce);
     
     // Cambiar estado de animacion
     startJump();
@@ -363,6 +371,8 @@ void CPlayer::takeDamage(int damage) {
             sprite.setFillColor(sf::Color::Black);
             std::cout << name << " ha muerto!\n";
         }
+        
+        CEventBus::getInstance().publish(GameEventType::PLAYER_DAMAGED, 0, damage, health);
     }
 }
 
@@ -470,14 +480,14 @@ void CPlayer::update(float deltaTime) {
     }
 }
 
-void CPlayer::render(sf::RenderWindow& window) {
+void CPlayer::render(sf::RenderTarget& target) {
     if (isAlive()) {
         if (texturesLoaded) {
             // Renderizar con textura y animacion
-            window.draw(playerSprite);
+            target.draw(playerSprite);
         } else {
             // Fallback: renderizar rectangulo de color
-            window.draw(sprite);
+            target.draw(sprite);
         }
     }
 }
@@ -574,25 +584,43 @@ void CPlayer::printPhysicsStatus() const {
 void CPlayer::loadPlayerTextures() {
     
     
-    // CARGAR CHARACTER.PNG - Sprite sheet completo
-    std::cout << "Intentando cargar: assets/Character.png" << std::endl;
-    if (!characterTexture.loadFromFile("assets/Character.png")) {
-        std::cerr << "Error: No se pudo cargar assets/Character.png" << std::endl;
-        texturesLoaded = false;
-        return;
-    }
+    // RESOLVER LA TABLA DE FRAMES - Primero el atlas; si no esta, Character.png desde el cache
+    const CTextureAtlas& atlas = CTextureAtlas::getInstance();
+    texturesLoaded = true;
     
-    sf::Vector2u sheetSize = characterTexture.getSize();
+    for (int i = 0; i < PLAYER_STATE_COUNT; i++) {
+        AtlasStripDef strip = getStripDef(static_cast<PlayerState>(i));
+        if (atlas.getStripFrames(strip.name, frameTables[i])) {
+            continue;
+        }
+        
+        if (!characterTexture) {
+            characterTexture = CTextureCache::getInstance().acquire("assets/Character.png");
+        }
+        CTextureAtlas::sliceStrip(characterTexture.get(), strip, frameTables[i]);
+        
+        if (frameTables[i].empty()) {
+            texturesLoaded = false;
+        }
+    }
     
-    // CONFIGURAR SPRITE INICIAL
-    texturesLoaded = true;
+    if (!texturesLoaded) {
+        return;
+    }
     
-    // Configurar sprite inicial con textura del sprite sheet
-    playerSprite.setTexture(characterTexture);
+    // Configurar sprite inicial (updateSpriteFrame asigna la textura del frame)
     playerSprite.setPosition(position);
     updateSpriteFrame(); // Configurar el primer frame (idle)
 }
 
+void CPlayer::registerAtlasSheets() {
+    std::vector<AtlasStripDef> strips;
+    for (int i = 0; i < PLAYER_STATE_COUNT; i++) {
+        strips.push_back(getStripDef(static_cast<PlayerState>(i)));
+    }
+    CTextureAtlas::getInstance().addSheet("assets/Character.png", strips);
+}
+
 void CPlayer::updateAnimation(float deltaTime) {
     if (!texturesLoaded) return;
     
@@ -647,76 +675,46 @@ void CPlayer::updateAnimation(float deltaTime) {
 void CPlayer::updateSpriteFrame() {
     if (!texturesLoaded) return;
     
-    // CONFIGURAR RECTANGULO DE RECORTE DEL SPRITE SHEET
-    sf::IntRect frameRect = getCurrentFrameRect();
-    playerSprite.setTextureRect(frameRect);
+    // CONFIGURAR TEXTURA (pagina del atlas) Y RECTANGULO DE RECORTE
+    const std::vector<AtlasFrame>& table = frameTables[static_cast<int>(currentState)];
+    const AtlasFrame& frame = table[currentFrame < static_cast<int>(table.size()) ? currentFrame : 0];
+    if (playerSprite.getTexture() != frame.texture) {
+        playerSprite.setTexture(*frame.texture);
+    }
+    playerSprite.setTextureRect(frame.rect);
 }
 
 sf::IntRect CPlayer::getCurrentFrameRect() const {
-    // CALCULAR POSICION EN EL SPRITE SHEET CON COORDENADAS MANUALES
-    // Cada animacion puede estar en cualquier parte de la imagen
-    
-    int startX = 0, startY = 0;
-    int frameWidth = 0, frameHeight = 0;
-    
-    // Determinar coordenadas de inicio y dimensiones segun el estado actual
-    switch (currentState) {
-        case PlayerState::IDLE:
-            startX = IDLE_START_X;
-            startY = IDLE_START_Y;
-            frameWidth = IDLE_FRAME_WIDTH;
-            frameHeight = IDLE_FRAME_HEIGHT;
-            break;
-            
+    // CONSULTAR LA TABLA DE FRAMES (resuelta en loadPlayerTextures)
+    const std::vector<AtlasFrame>& table = frameTables[static_cast<int>(currentState)];
+    if (table.empty()) {
+        return sf::IntRect(0, 0, 0, 0);
+    }
+    return table[currentFrame < static_cast<int>(table.size()) ? currentFrame : 0].rect;
+}
+
+AtlasStripDef CPlayer::getStripDef(PlayerState state) {
+    // COORDENADAS MANUALES EN Character.png
+    // Cada animacion puede estar en cualquier parte de la imagen: x = startX + (frame * frameWidth), y = startY
+    switch (state) {
         case PlayerState::RUNNING:
-            startX = RUN_START_X;
-            startY = RUN_START_Y;
-            frameWidth = RUN_FRAME_WIDTH;
-            frameHeight = RUN_FRAME_HEIGHT;
-            break;
+            return {"player.run", RUN_START_X, RUN_START_Y, RUN_FRAME_COUNT, RUN_FRAME_WIDTH, RUN_FRAME_HEIGHT};
             
         case PlayerState::ATTACKING:
-            startX = ATTACK_START_X;
-            startY = ATTACK_START_Y;
-            frameWidth = ATTACK_FRAME_WIDTH;
-            frameHeight = ATTACK_FRAME_HEIGHT;
-            break;
+            return {"player.attack", ATTACK_START_X, ATTACK_START_Y, ATTACK_FRAME_COUNT, ATTACK_FRAME_WIDTH, ATTACK_FRAME_HEIGHT};
             
         case PlayerState::HURT:
-            startX = HURT_START_X;
-            startY = HURT_START_Y;
-            frameWidth = HURT_FRAME_WIDTH;
-            frameHeight = HURT_FRAME_HEIGHT;
-            break;
+            return {"player.hurt", HURT_START_X, HURT_START_Y, HURT_FRAME_COUNT, HURT_FRAME_WIDTH, HURT_FRAME_HEIGHT};
             
         // Estados de salto y caida
         case PlayerState::JUMPING:
-            startX = JUMP_START_X;
-            startY = JUMP_START_Y;
-            frameWidth = JUMP_FRAME_WIDTH;
-            frameHeight = JUMP_FRAME_HEIGHT;
-            break;
+            return {"player.jump", JUMP_START_X, JUMP_START_Y, JUMP_FRAME_COUNT, JUMP_FRAME_WIDTH, JUMP_FRAME_HEIGHT};
             
         case PlayerState::FALLING:
-            startX = FALL_START_X;
-            startY = FALL_START_Y;
-            frameWidth = FALL_FRAME_WIDTH;
-            frameHeight = FALL_FRAME_HEIGHT;
-            break;
+            return {"player.fall", FALL_START_X, FALL_START_Y, FALL_FRAME_COUNT, FALL_FRAME_WIDTH, FALL_FRAME_HEIGHT};
         
+        case PlayerState::IDLE:
         default:
-            // Por defecto, usar idle
-            startX = IDLE_START_X;
-            startY = IDLE_START_Y;
-            frameWidth = IDLE_FRAME_WIDTH;
-            frameHeight = IDLE_FRAME_HEIGHT;
-            break;
+            return {"player.idle", IDLE_START_X, IDLE_START_Y, IDLE_FRAME_COUNT, IDLE_FRAME_WIDTH, IDLE_FRAME_HEIGHT};
     }
-    
-    // CALCULAR COORDENADAS DEL FRAME ACTUAL
-    // NUEVA FORMULA: x = startX + (frame * frameWidth), y = startY
-    int x = startX + (currentFrame * frameWidth);   // Posicion horizontal desde el inicio
-    int y = startY;                                   // Posicion vertical fija (inicio Y)
-    
-    return sf::IntRect(x, y, frameWidth, frameHeight);
 }
\ No newline at end of file
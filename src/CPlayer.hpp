@@ -4,8 +4,9 @@
 #include <string>
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>  // ← NUEVO: Box2D
-
-class CPhysics;  // Forward declaration
+#include "CTextureCache.hpp"
+#include "CTextureAtlas.hpp"
+#include "CPhysics.hpp"     // BodyHandle
 
 class CPlayer {
 private:
@@ -20,7 +21,8 @@ private:
     // NUEVO: Sistema de físicas
     // ===================================
     CPhysics* physics;              // Referencia al sistema de físicas
-    b2Body* physicsBody;            // Cuerpo físico del jugador
+    BodyHandle physicsHandle;       // Handle del cuerpo en CPhysics
+    b2Body* physicsBody;            // Cuerpo físico del jugador (cacheado desde el handle)
     bool physicsEnabled;            // Si las físicas están activas
     bool grounded;                  // Si está en el suelo
     float jumpForce;                // Fuerza de salto
@@ -30,7 +32,7 @@ private:
     sf::Color color;
     
     // Texturas y sprites
-    sf::Texture characterTexture;    // Sprite sheet completo del personaje
+    TextureHandle characterTexture;  // Sprite sheet completo del personaje (compartido)
     sf::Sprite playerSprite;
     bool texturesLoaded;
     
@@ -44,6 +46,11 @@ private:
         FALLING                       // ← NUEVO: Estado de caída
     };
     
+    static const int PLAYER_STATE_COUNT = 6;
+    
+    // Tabla de frames por estado (página del atlas o Character.png suelto)
+    std::vector<AtlasFrame> frameTables[PLAYER_STATE_COUNT];
+    
     PlayerState currentState;
     int currentFrame;
     float animationTimer;
@@ -145,6 +152,7 @@ public:
     bool isJumping() const;
     bool isFalling() const;
     b2Body* getPhysicsBody() const;
+    BodyHandle getPhysicsHandle() const;
     sf::Vector2f getVelocity() const;
     
     // Setters
@@ -186,7 +194,7 @@ public:
     
     // Métodos SFML
     void update(float deltaTime);
-    void render(sf::RenderWindow& window);
+    void render(sf::RenderTarget& target);
     
     // Debug
     void printStatus() const;
@@ -194,6 +202,9 @@ public:
     void debugCurrentFrame() const; 
     void printPhysicsStatus() const;             // ← NUEVO: Debug de físicas
     
+    // Atlas de texturas: registrar las tiras de Character.png antes de CTextureAtlas::build()
+    static void registerAtlasSheets();
+    
 private:
     // Métodos privados
     void loadPlayerTextures();
@@ -201,6 +212,7 @@ private:
     void updateSpriteFrame();
     void updatePhysicsState();                   // ← NUEVO: Actualizar estado según físicas
     sf::IntRect getCurrentFrameRect() const;
+    static AtlasStripDef getStripDef(PlayerState state);
     
     // ===================================
     // NUEVO: Métodos de físicas privados
@@ -0,0 +1,256 @@
+#include "CProfiler.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+namespace {
+    const float NS_TO_MS = 1.0f / 1000000.0f;
+
+    // Geometría del overlay (esquina superior derecha de la ventana 800x600)
+    const float OVERLAY_WIDTH = 260.0f;
+    const float OVERLAY_MARGIN = 10.0f;
+    const float GRAPH_HEIGHT = 60.0f;
+    const float GRAPH_MAX_MS = 33.3f;              // Escala del gráfico: 2 frames a 60 FPS
+    const float TARGET_FRAME_MS = 1000.0f / 60.0f;
+}
+
+// Constructor
+CProfiler::CProfiler()
+    : enabled(false), enablePending(false), overlayVisible(false), currentFrame(), history(),
+      framesWritten(0), cachedZoneStats(), cachedFrameStats{0.0f, 0.0f}, statsFrame(0),
+      drawCalls(0), drawVertices(0) {
+}
+
+// CONTROL
+void CProfiler::setEnabled(bool enable) {
+    if (enable) {
+        if (!enabled && !enablePending) {
+            // Empezar con historial limpio para no mezclar sesiones
+            framesWritten.store(0, std::memory_order_release);
+            currentFrame = FrameTiming();
+            statsFrame = 0;
+
+            // Puede llegar a mitad de frame (F10 desde handleEvents): se mide a partir del
+            // siguiente beginFrame(), para no guardar un frame sin inicio
+            enablePending = true;
+        }
+        return;
+    }
+
+    enabled = false;
+    enablePending = false;
+    overlayVisible = false;
+}
+
+void CProfiler::toggleOverlay() {
+    if (!overlayVisible) {
+        setEnabled(true);
+        overlayVisible = true;
+    } else {
+        overlayVisible = false;
+    }
+}
+
+bool CProfiler::isOverlayVisible() const {
+    return overlayVisible;
+}
+
+// MEDICION
+void CProfiler::beginFrame() {
+    if (enablePending) {
+        enabled = true;
+        enablePending = false;
+    }
+    if (!enabled) return;
+
+    currentFrame = FrameTiming();
+    frameStart = Clock::now();
+}
+
+void CProfiler::endFrame() {
+    if (!enabled) return;
+
+    currentFrame.frameNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - frameStart).count();
+
+    // Un solo escritor: copiar el frame y después publicar el nuevo contador
+    uint64_t written = framesWritten.load(std::memory_order_relaxed);
+    history[written % HISTORY_SIZE] = currentFrame;
+    framesWritten.store(written + 1, std::memory_order_release);
+}
+
+// CONSULTAS
+size_t CProfiler::getFrameCount() const {
+    uint64_t written = framesWritten.load(std::memory_order_acquire);
+    return static_cast<size_t>(std::min<uint64_t>(written, HISTORY_SIZE));
+}
+
+bool CProfiler::getFrame(size_t age, FrameTiming& frame) const {
+    uint64_t written = framesWritten.load(std::memory_order_acquire);
+    if (age >= std::min<uint64_t>(written, HISTORY_SIZE)) {
+        return false;
+    }
+
+    frame = history[(written - 1 - age) % HISTORY_SIZE];
+    return true;
+}
+
+ZoneStats CProfiler::getZoneStats(ProfileZone zone) const {
+    return computeStats(static_cast<int>(zone));
+}
+
+ZoneStats CProfiler::getFrameStats() const {
+    return computeStats(-1);
+}
+
+const char* CProfiler::getZoneName(ProfileZone zone) {
+    switch (zone) {
+        case ProfileZone::HANDLE_EVENTS: return "handleEvents";
+        case ProfileZone::HANDLE_INPUT: return "handleInput";
+        case ProfileZone::UPDATE_GAMEPLAY: return "updateGameplay";
+        case ProfileZone::UPDATE_PHYSICS: return "updatePhysics";
+        case ProfileZone::UPDATE_MUSIC: return "updateMusic";
+        case ProfileZone::UPDATE_UI: return "updateUI";
+        case ProfileZone::RENDER: return "render";
+        default: return "Desconocida";
+    }
+}
+
+// SALIDA
+void CProfiler::renderOverlay(sf::RenderTarget& target, const sf::Font* font) {
+    if (!overlayVisible) return;
+
+    size_t frameCount = getFrameCount();
+    if (frameCount == 0) return;
+
+    uint64_t written = framesWritten.load(std::memory_order_acquire);
+    if (written >= statsFrame + STATS_REFRESH_FRAMES || statsFrame == 0) {
+        refreshCachedStats();
+        statsFrame = written;
+    }
+
+    // Dibujar en coordenadas de pantalla aunque haya una vista de cámara activa
+    sf::View previousView = target.getView();
+    target.setView(target.getDefaultView());
+
+    float left = target.getSize().x - OVERLAY_WIDTH - OVERLAY_MARGIN;
+    float top = OVERLAY_MARGIN;
+    float lineHeight = 14.0f;
+    float textHeight = lineHeight * (PROFILE_ZONE_COUNT + 3);
+
+    sf::RectangleShape panel(sf::Vector2f(OVERLAY_WIDTH, GRAPH_HEIGHT + textHeight + 12.0f));
+    panel.setPosition(left, top);
+    panel.setFillColor(sf::Color(0, 0, 0, 180));
+    target.draw(panel);
+
+    // Gráfico de tiempo de frame: una barra por frame, el más reciente a la derecha
+    sf::VertexArray bars(sf::Lines, frameCount * 2);
+    float barSpacing = OVERLAY_WIDTH / HISTORY_SIZE;
+    float graphBottom = top + GRAPH_HEIGHT;
+
+    for (size_t age = 0; age < frameCount; age++) {
+        FrameTiming frame;
+        getFrame(age, frame);
+
+        float frameMs = frame.frameNs * NS_TO_MS;
+        float barHeight = std::min(frameMs / GRAPH_MAX_MS, 1.0f) * GRAPH_HEIGHT;
+        float x = left + OVERLAY_WIDTH - 1.0f - age * barSpacing;
+        sf::Color color = frameMs > TARGET_FRAME_MS * 1.5f ? sf::Color::Red :
+                          (frameMs > TARGET_FRAME_MS * 1.05f ? sf::Color::Yellow : sf::Color::Green);
+
+        bars[age * 2] = sf::Vertex(sf::Vector2f(x, graphBottom), color);
+        bars[age * 2 + 1] = sf::Vertex(sf::Vector2f(x, graphBottom - barHeight), color);
+    }
+    target.draw(bars);
+
+    // Línea de referencia de 16.7 ms
+    float targetY = graphBottom - (TARGET_FRAME_MS / GRAPH_MAX_MS) * GRAPH_HEIGHT;
+    sf::VertexArray targetLine(sf::Lines, 2);
+    targetLine[0] = sf::Vertex(sf::Vector2f(left, targetY), sf::Color(255, 255, 255, 120));
+    targetLine[1] = sf::Vertex(sf::Vector2f(left + OVERLAY_WIDTH, targetY), sf::Color(255, 255, 255, 120));
+    target.draw(targetLine);
+
+    if (font) {
+        std::ostringstream lines;
+        lines << std::fixed << std::setprecision(2);
+        lines << "frame          avg " << cachedFrameStats.averageMs << "  p99 " << cachedFrameStats.p99Ms << " ms\n";
+        for (size_t i = 0; i < PROFILE_ZONE_COUNT; i++) {
+            std::string name = getZoneName(static_cast<ProfileZone>(i));
+            name.resize(14, ' ');
+            lines << name << " avg " << cachedZoneStats[i].averageMs << "  p99 " << cachedZoneStats[i].p99Ms << "\n";
+        }
+        lines << "draw calls     " << drawCalls << "  vertices " << drawVertices << "\n";
+
+        sf::Text text;
+        text.setFont(*font);
+        text.setCharacterSize(11);
+        text.setFillColor(sf::Color::White);
+        text.setString(lines.str());
+        text.setPosition(left + 6.0f, graphBottom + 6.0f);
+        target.draw(text);
+    }
+
+    target.setView(previousView);
+}
+
+void CProfiler::printSummary() const {
+    size_t frameCount = getFrameCount();
+    if (frameCount == 0) {
+        std::cout << "Profiler: sin frames registrados" << std::endl;
+        return;
+    }
+
+    ZoneStats frameStats = getFrameStats();
+
+    // Como en el overlay: formato en un stream local, sin tocar la precisión de std::cout
+    std::ostringstream lines;
+    lines << std::fixed << std::setprecision(3);
+    lines << "=== Profiler (ultimos " << frameCount << " frames, ms) ===\n";
+    lines << "  frame: media " << frameStats.averageMs << " | p99 " << frameStats.p99Ms << "\n";
+    for (size_t i = 0; i < PROFILE_ZONE_COUNT; i++) {
+        ZoneStats stats = computeStats(static_cast<int>(i));
+        lines << "  " << getZoneName(static_cast<ProfileZone>(i)) << ": media " << stats.averageMs
+              << " | p99 " << stats.p99Ms << "\n";
+    }
+    lines << "===============================\n";
+    std::cout << lines.str() << std::flush;
+}
+
+// METODOS PRIVADOS
+ZoneStats CProfiler::computeStats(int zoneIndex) const {
+    ZoneStats stats{0.0f, 0.0f};
+
+    size_t frameCount = getFrameCount();
+    if (frameCount == 0) return stats;
+
+    std::vector<uint64_t> samples;
+    samples.reserve(frameCount);
+
+    for (size_t age = 0; age < frameCount; age++) {
+        FrameTiming frame;
+        if (!getFrame(age, frame)) break;
+        samples.push_back(zoneIndex < 0 ? frame.frameNs : frame.zoneNs[zoneIndex]);
+    }
+
+    uint64_t total = 0;
+    for (uint64_t sample : samples) {
+        total += sample;
+    }
+
+    // p99 sin ordenar todo el historial
+    size_t p99Index = std::min(samples.size() - 1, (samples.size() * 99) / 100);
+    std::nth_element(samples.begin(), samples.begin() + p99Index, samples.end());
+
+    stats.averageMs = (static_cast<float>(total) / samples.size()) * NS_TO_MS;
+    stats.p99Ms = samples[p99Index] * NS_TO_MS;
+    return stats;
+}
+
+void CProfiler::refreshCachedStats() {
+    cachedFrameStats = computeStats(-1);
+    for (size_t i = 0; i < PROFILE_ZONE_COUNT; i++) {
+        cachedZoneStats[i] = computeStats(static_cast<int>(i));
+    }
+}
@@ -0,0 +1,162 @@
+#ifndef CPROFILER_HPP
+#define CPROFILER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "CTraceWriter.hpp"
+
+// Zonas medidas en cada frame (ver CGame::run)
+enum class ProfileZone {
+    HANDLE_EVENTS,
+    HANDLE_INPUT,
+    UPDATE_GAMEPLAY,
+    UPDATE_PHYSICS,
+    UPDATE_MUSIC,
+    UPDATE_UI,
+    RENDER,
+    COUNT
+};
+
+const size_t PROFILE_ZONE_COUNT = static_cast<size_t>(ProfileZone::COUNT);
+
+// Tiempos de un frame completo
+struct FrameTiming {
+    uint64_t frameNs;
+    std::array<uint64_t, PROFILE_ZONE_COUNT> zoneNs;
+};
+
+// Media y p99 sobre el historial (en milisegundos)
+struct ZoneStats {
+    float averageMs;
+    float p99Ms;
+};
+
+// ===============================================
+// Profiler por frame con zonas y overlay
+// ===============================================
+// Los frames terminados se guardan en un ring buffer de tamaño fijo: escribe
+// solo el hilo principal y publica el índice con un atómico, así los lectores
+// no necesitan locks. Desactivado, cada zona cuesta una comprobación de bool.
+class CProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static const size_t HISTORY_SIZE = 256;        // Frames en el historial (~4 s a 60 FPS)
+
+private:
+    bool enabled;
+    bool enablePending;                            // setEnabled(true) pendiente del siguiente beginFrame()
+    bool overlayVisible;
+
+    // Frame en curso
+    Clock::time_point frameStart;
+    FrameTiming currentFrame;
+
+    // Ring buffer de frames terminados
+    std::array<FrameTiming, HISTORY_SIZE> history;
+    std::atomic<uint64_t> framesWritten;
+
+    // Estadísticas cacheadas para el overlay (se recalculan cada pocos frames)
+    std::array<ZoneStats, PROFILE_ZONE_COUNT> cachedZoneStats;
+    ZoneStats cachedFrameStats;
+    uint64_t statsFrame;
+
+    // Coste de dibujo del último frame (lo informa quien renderiza)
+    size_t drawCalls;
+    size_t drawVertices;
+
+    CProfiler();
+
+public:
+    static const size_t STATS_REFRESH_FRAMES = 15;
+
+    CProfiler(const CProfiler&) = delete;
+    CProfiler& operator=(const CProfiler&) = delete;
+
+    // Inline: las zonas desactivadas no pagan una llamada a función
+    static CProfiler& getInstance() {
+        static CProfiler instance;
+        return instance;
+    }
+
+    // Control
+    void setEnabled(bool enable);
+    bool isEnabled() const { return enabled; }     // Midiendo en este frame
+    void toggleOverlay();                          // También activa el profiler si estaba apagado
+    bool isOverlayVisible() const;
+
+    // Medición (llamadas desde el bucle principal)
+    void beginFrame();
+    void endFrame();
+    void addZoneTime(ProfileZone zone, uint64_t nanoseconds) {
+        currentFrame.zoneNs[static_cast<size_t>(zone)] += nanoseconds;
+    }
+    void setDrawStats(size_t calls, size_t vertices) {
+        drawCalls = calls;
+        drawVertices = vertices;
+    }
+
+    // Consultas
+    size_t getFrameCount() const;                  // Frames válidos en el historial
+    bool getFrame(size_t age, FrameTiming& frame) const;  // age 0 = último frame terminado
+    ZoneStats getZoneStats(ProfileZone zone) const;
+    ZoneStats getFrameStats() const;
+    static const char* getZoneName(ProfileZone zone);
+
+    // Salida
+    void renderOverlay(sf::RenderTarget& target, const sf::Font* font);
+    void printSummary() const;
+
+private:
+    ZoneStats computeStats(int zoneIndex) const;   // -1 = frame completo
+    void refreshCachedStats();
+};
+
+// Zona con ámbito: mide desde el constructor hasta el destructor.
+// Alimenta al profiler y, si hay una traza activa, también a CTraceWriter
+class CProfileScope {
+private:
+    ProfileZone zone;
+    bool profiling;
+    bool tracing;
+    CProfiler::Clock::time_point start;
+
+public:
+    explicit CProfileScope(ProfileZone zone)
+        : zone(zone), profiling(CProfiler::getInstance().isEnabled()),
+          tracing(CTraceWriter::getInstance().isActive()) {
+        if (profiling || tracing) {
+            start = CProfiler::Clock::now();
+        }
+    }
+
+    ~CProfileScope() {
+        if (!profiling && !tracing) return;
+
+        CProfiler::Clock::time_point end = CProfiler::Clock::now();
+        if (profiling) {
+            CProfiler::getInstance().addZoneTime(zone,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+        if (tracing) {
+            CTraceWriter::getInstance().record(CProfiler::getZoneName(zone), start, end);
+        }
+    }
+
+    CProfileScope(const CProfileScope&) = delete;
+    CProfileScope& operator=(const CProfileScope&) = delete;
+};
+
+// Compilar con -DNO_PROFILER elimina las zonas por completo
+#ifdef NO_PROFILER
+#define PROFILE_ZONE(zone)
+#else
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(zone) CProfileScope PROFILE_CONCAT(profileScope, __LINE__)(zone)
+#endif
+
+#endif // CPROFILER_HPP
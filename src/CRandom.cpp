@@ -0,0 +1,49 @@
+#include "CRandom.hpp"
+
+// Constructor
+CRandom::CRandom(uint32_t seed) : seed(seed), state(0) {
+    setSeed(seed);
+}
+
+CRandom& CRandom::getGlobal() {
+    static CRandom instance;
+    return instance;
+}
+
+// SEMILLA
+void CRandom::setSeed(uint32_t newSeed) {
+    seed = newSeed;
+    // xorshift no admite estado 0
+    state = (newSeed != 0) ? newSeed : DEFAULT_SEED;
+}
+
+uint32_t CRandom::getSeed() const {
+    return seed;
+}
+
+uint32_t CRandom::getState() const {
+    return state;
+}
+
+// GENERACION
+uint32_t CRandom::next() {
+    uint32_t x = state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state = x;
+    return x;
+}
+
+int CRandom::nextInt(int minValue, int maxValue) {
+    if (maxValue <= minValue) {
+        return minValue;
+    }
+    uint32_t range = static_cast<uint32_t>(maxValue - minValue) + 1;
+    return minValue + static_cast<int>(next() % range);
+}
+
+float CRandom::nextFloat() {
+    // 24 bits de mantisa: resultado exacto en float
+    return (next() >> 8) * (1.0f / 16777216.0f);
+}
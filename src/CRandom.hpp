@@ -0,0 +1,33 @@
+#ifndef CRANDOM_HPP
+#define CRANDOM_HPP
+
+#include <cstdint>
+
+// ===============================================
+// Generador pseudoaleatorio reproducible (xorshift32)
+// ===============================================
+// Sustituye a rand(): la secuencia depende solo de la semilla, así que una
+// partida grabada se puede reproducir exactamente guardando la semilla.
+class CRandom {
+private:
+    uint32_t seed;
+    uint32_t state;
+
+public:
+    static const uint32_t DEFAULT_SEED = 0x9E3779B9u;
+
+    explicit CRandom(uint32_t seed = DEFAULT_SEED);
+
+    // Generador compartido por la lógica del juego
+    static CRandom& getGlobal();
+
+    void setSeed(uint32_t newSeed);
+    uint32_t getSeed() const;
+    uint32_t getState() const;                    // Para el hash de estado de los replays
+
+    uint32_t next();
+    int nextInt(int minValue, int maxValue);      // Rango cerrado [minValue, maxValue]
+    float nextFloat();                            // [0, 1)
+};
+
+#endif // CRANDOM_HPP
@@ -0,0 +1,202 @@
+#include "CReplay.hpp"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    const char MAGIC[4] = {'C', 'V', 'R', 'P'};
+
+    template<typename T>
+    void writeValue(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool readValue(std::ifstream& file, T& value) {
+        file.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return static_cast<bool>(file);
+    }
+}
+
+// Constructor
+CReplay::CReplay() : flags(0), seed(0), stepRate(0) {
+}
+
+// GRABACION
+void CReplay::begin(uint32_t randomSeed, uint32_t ticksPerSecond, uint16_t sessionFlags) {
+    flags = sessionFlags;
+    seed = randomSeed;
+    stepRate = ticksPerSecond;
+    inputs.clear();
+    checkpoints.clear();
+}
+
+void CReplay::recordTick(InputMask mask) {
+    inputs.push_back(mask);
+}
+
+void CReplay::addCheckpoint(uint32_t tick, uint64_t stateHash) {
+    checkpoints.push_back({tick, stateHash});
+}
+
+bool CReplay::saveToFile(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "CReplay: No se pudo crear " << path << std::endl;
+        return false;
+    }
+
+    // La entrada cambia pocas veces por segundo: RLE la reduce a unos pocos tramos
+    std::vector<std::pair<InputMask, uint32_t>> runs;
+    for (InputMask mask : inputs) {
+        if (!runs.empty() && runs.back().first == mask) {
+            runs.back().second++;
+        } else {
+            runs.emplace_back(mask, 1);
+        }
+    }
+
+    file.write(MAGIC, sizeof(MAGIC));
+    writeValue(file, FORMAT_VERSION);
+    writeValue(file, flags);
+    writeValue(file, seed);
+    writeValue(file, stepRate);
+    writeValue(file, static_cast<uint32_t>(inputs.size()));
+
+    writeValue(file, static_cast<uint32_t>(runs.size()));
+    for (const auto& run : runs) {
+        writeValue(file, run.first);
+        writeValue(file, run.second);
+    }
+
+    writeValue(file, static_cast<uint32_t>(checkpoints.size()));
+    for (const ReplayCheckpoint& checkpoint : checkpoints) {
+        writeValue(file, checkpoint.tick);
+        writeValue(file, checkpoint.stateHash);
+    }
+
+    if (!file) {
+        std::cerr << "CReplay: Error escribiendo " << path << std::endl;
+        return false;
+    }
+
+    std::cout << "CReplay: " << inputs.size() << " ticks (" << runs.size() << " tramos, "
+              << checkpoints.size() << " checkpoints) guardados en " << path << std::endl;
+    return true;
+}
+
+// REPRODUCCION
+bool CReplay::loadFromFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "CReplay: No se pudo abrir " << path << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    uint16_t version = 0;
+    file.read(magic, sizeof(magic));
+    if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || !readValue(file, version)) {
+        std::cerr << "CReplay: " << path << " no es un replay valido" << std::endl;
+        return false;
+    }
+
+    if (version != FORMAT_VERSION) {
+        std::cerr << "CReplay: Version " << version << " no soportada (se esperaba "
+                  << FORMAT_VERSION << ")" << std::endl;
+        return false;
+    }
+
+    uint32_t tickCount = 0;
+    uint32_t runCount = 0;
+    if (!readValue(file, flags) || !readValue(file, seed) || !readValue(file, stepRate) ||
+        !readValue(file, tickCount) || !readValue(file, runCount)) {
+        std::cerr << "CReplay: Cabecera incompleta en " << path << std::endl;
+        return false;
+    }
+
+    inputs.clear();
+    inputs.reserve(tickCount);
+    for (uint32_t i = 0; i < runCount; i++) {
+        InputMask mask = 0;
+        uint32_t length = 0;
+        if (!readValue(file, mask) || !readValue(file, length)) {
+            std::cerr << "CReplay: Datos de entrada incompletos en " << path << std::endl;
+            return false;
+        }
+        inputs.insert(inputs.end(), length, mask);
+    }
+
+    if (inputs.size() != tickCount) {
+        std::cerr << "CReplay: Se esperaban " << tickCount << " ticks y hay " << inputs.size() << std::endl;
+        return false;
+    }
+
+    uint32_t checkpointCount = 0;
+    checkpoints.clear();
+    if (readValue(file, checkpointCount)) {
+        checkpoints.reserve(checkpointCount);
+        for (uint32_t i = 0; i < checkpointCount; i++) {
+            ReplayCheckpoint checkpoint;
+            if (!readValue(file, checkpoint.tick) || !readValue(file, checkpoint.stateHash)) {
+                break;
+            }
+            checkpoints.push_back(checkpoint);
+        }
+    }
+
+    std::cout << "CReplay: " << inputs.size() << " ticks cargados de " << path
+              << " (semilla " << seed << ", " << stepRate << " pasos/s)" << std::endl;
+    return true;
+}
+
+InputMask CReplay::getInput(long tick) const {
+    if (tick < 0 || tick >= static_cast<long>(inputs.size())) {
+        return 0;
+    }
+    return inputs[tick];
+}
+
+const ReplayCheckpoint* CReplay::findCheckpoint(uint32_t tick) const {
+    auto it = std::lower_bound(checkpoints.begin(), checkpoints.end(), tick,
+        [](const ReplayCheckpoint& checkpoint, uint32_t value) {
+            return checkpoint.tick < value;
+        });
+
+    if (it == checkpoints.end() || it->tick != tick) {
+        return nullptr;
+    }
+    return &(*it);
+}
+
+// GETTERS
+uint16_t CReplay::getFlags() const {
+    return flags;
+}
+
+uint32_t CReplay::getSeed() const {
+    return seed;
+}
+
+uint32_t CReplay::getStepRate() const {
+    return stepRate;
+}
+
+size_t CReplay::getTickCount() const {
+    return inputs.size();
+}
+
+size_t CReplay::getCheckpointCount() const {
+    return checkpoints.size();
+}
+
+// UTILIDADES
+uint64_t CReplay::hashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
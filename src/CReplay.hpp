@@ -0,0 +1,70 @@
+#ifndef CREPLAY_HPP
+#define CREPLAY_HPP
+
+#include "CInput.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Hash del estado de la simulación en un tick concreto
+struct ReplayCheckpoint {
+    uint32_t tick;
+    uint64_t stateHash;
+};
+
+// ===============================================
+// Grabación y reproducción determinista de partidas
+// ===============================================
+// Se guarda la semilla del generador aleatorio, el paso fijo y las acciones de
+// cada tick (InputMask de CInput, no teclas: no depende de la asignación de
+// teclas). Con el mismo binario, reproducir el archivo da exactamente el mismo
+// estado; los checkpoints (hash cada CHECKPOINT_INTERVAL ticks) lo verifican.
+//
+// Formato binario (little endian):
+//   "CVRP" | u16 versión | u16 flags | u32 semilla | u32 pasos/s | u32 ticks
+//   u32 nº de tramos | tramos RLE { u32 máscara, u32 repeticiones }
+//   u32 nº de checkpoints | checkpoints { u32 tick, u64 hash }
+class CReplay {
+private:
+    uint16_t flags;
+    uint32_t seed;
+    uint32_t stepRate;
+    std::vector<InputMask> inputs;                // Un elemento por tick
+    std::vector<ReplayCheckpoint> checkpoints;    // Ordenados por tick
+
+public:
+    static const uint16_t FORMAT_VERSION = 2;     // 2: máscaras de acciones
+    static const uint16_t FLAG_HEADLESS = 1;      // Grabado sin texturas (cambia los bounds de los enemigos)
+    static const uint32_t CHECKPOINT_INTERVAL = 60;
+    static const uint64_t HASH_SEED = 14695981039346656037ull;  // FNV-1a
+
+    CReplay();
+
+    // Grabación
+    void begin(uint32_t randomSeed, uint32_t ticksPerSecond, uint16_t sessionFlags);
+    void recordTick(InputMask mask);
+    void addCheckpoint(uint32_t tick, uint64_t stateHash);
+    bool saveToFile(const std::string& path) const;
+
+    // Reproducción
+    bool loadFromFile(const std::string& path);
+    InputMask getInput(long tick) const;          // 0 (nada pulsado) fuera de rango
+    const ReplayCheckpoint* findCheckpoint(uint32_t tick) const;
+
+    // Getters
+    uint16_t getFlags() const;
+    uint32_t getSeed() const;
+    uint32_t getStepRate() const;
+    size_t getTickCount() const;
+    size_t getCheckpointCount() const;
+
+    // Utilidades
+    static uint64_t hashBytes(uint64_t hash, const void* data, size_t size);
+
+    template<typename T>
+    static uint64_t hashValue(uint64_t hash, const T& value) {
+        return hashBytes(hash, &value, sizeof(T));
+    }
+};
+
+#endif // CREPLAY_HPP
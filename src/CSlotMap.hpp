@@ -0,0 +1,160 @@
+#ifndef CSLOTMAP_HPP
+#define CSLOTMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Handle tipado con generación: deja de ser válido en cuanto se borra su elemento,
+// aunque el hueco se reutilice después para otro
+template<typename T>
+struct SlotHandle {
+    static const uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t index;
+    uint32_t generation;
+
+    SlotHandle() : index(INVALID_INDEX), generation(0) {}
+    SlotHandle(uint32_t i, uint32_t g) : index(i), generation(g) {}
+
+    // Indica si el handle se ha asignado alguna vez (no si el elemento sigue vivo)
+    bool isValid() const { return index != INVALID_INDEX; }
+
+    // Empaquetado en 64 bits (para guardarlo en userData de Box2D)
+    uint64_t pack() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+    static SlotHandle unpack(uint64_t value) {
+        return SlotHandle(static_cast<uint32_t>(value & 0xFFFFFFFFu), static_cast<uint32_t>(value >> 32));
+    }
+
+    bool operator==(const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+// ===============================================
+// Slot map con índices generacionales
+// ===============================================
+// Los elementos viven contiguos en un vector (iteración sin saltos de caché);
+// cada handle apunta a un slot que guarda la posición actual del elemento.
+// Inserción, búsqueda y borrado son O(1): al borrar, el último elemento ocupa
+// el hueco (swap-and-pop). El orden de iteración solo depende de la secuencia
+// de inserciones y borrados, nunca de direcciones de memoria.
+template<typename T>
+class CSlotMap {
+public:
+    using Handle = SlotHandle<T>;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+private:
+    struct Slot {
+        uint32_t denseIndex;     // Posición en items, o siguiente slot libre si está libre
+        uint32_t generation;     // Impar = ocupado, par = libre
+    };
+
+    std::vector<T> items;
+    std::vector<uint32_t> itemSlots;     // Slot de cada elemento de items
+    std::vector<Slot> slots;
+    uint32_t freeHead;
+
+public:
+    CSlotMap() : freeHead(Handle::INVALID_INDEX) {}
+
+    template<typename... Args>
+    Handle emplace(Args&&... args) {
+        uint32_t slotIndex;
+        if (freeHead != Handle::INVALID_INDEX) {
+            slotIndex = freeHead;
+            freeHead = slots[slotIndex].denseIndex;
+        } else {
+            slotIndex = static_cast<uint32_t>(slots.size());
+            slots.push_back({0, 0});
+        }
+
+        Slot& slot = slots[slotIndex];
+        slot.generation++;
+        slot.denseIndex = static_cast<uint32_t>(items.size());
+
+        items.emplace_back(std::forward<Args>(args)...);
+        itemSlots.push_back(slotIndex);
+
+        return Handle(slotIndex, slot.generation);
+    }
+
+    Handle insert(const T& value) {
+        return emplace(value);
+    }
+
+    bool erase(Handle handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+
+        Slot& slot = slots[handle.index];
+        uint32_t removed = slot.denseIndex;
+        uint32_t last = static_cast<uint32_t>(items.size()) - 1;
+
+        // Mover el último elemento al hueco y actualizar su slot
+        if (removed != last) {
+            items[removed] = std::move(items[last]);
+            itemSlots[removed] = itemSlots[last];
+            slots[itemSlots[removed]].denseIndex = removed;
+        }
+        items.pop_back();
+        itemSlots.pop_back();
+
+        // Invalidar handles antiguos y encadenar el slot en la lista libre
+        slot.generation++;
+        slot.denseIndex = freeHead;
+        freeHead = handle.index;
+        return true;
+    }
+
+    bool contains(Handle handle) const {
+        return handle.index < slots.size() &&
+               slots[handle.index].generation == handle.generation &&
+               (handle.generation & 1u) != 0;
+    }
+
+    T* get(Handle handle) {
+        return contains(handle) ? &items[slots[handle.index].denseIndex] : nullptr;
+    }
+
+    const T* get(Handle handle) const {
+        return contains(handle) ? &items[slots[handle.index].denseIndex] : nullptr;
+    }
+
+    // Handle del elemento en la posición densa i (0 <= i < size())
+    Handle handleAt(size_t denseIndex) const {
+        uint32_t slotIndex = itemSlots[denseIndex];
+        return Handle(slotIndex, slots[slotIndex].generation);
+    }
+
+    void reserve(size_t capacity) {
+        items.reserve(capacity);
+        itemSlots.reserve(capacity);
+        slots.reserve(capacity);
+    }
+
+    void clear() {
+        // Los handles existentes quedan invalidados: cada slot ocupado pasa a libre
+        for (uint32_t slotIndex : itemSlots) {
+            Slot& slot = slots[slotIndex];
+            slot.generation++;
+            slot.denseIndex = freeHead;
+            freeHead = slotIndex;
+        }
+        items.clear();
+        itemSlots.clear();
+    }
+
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+    iterator begin() { return items.begin(); }
+    iterator end() { return items.end(); }
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+};
+
+#endif // CSLOTMAP_HPP
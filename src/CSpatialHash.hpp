@@ -0,0 +1,382 @@
+#ifndef CSPATIALHASH_HPP
+#define CSPATIALHASH_HPP
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Filtro por defecto de las consultas: acepta todos los elementos
+struct SpatialAcceptAll {
+    template<typename T>
+    bool operator()(const T*) const { return true; }
+};
+
+// ===============================================
+// Hash espacial de rejilla uniforme
+// ===============================================
+// Reparte punteros a entidades en celdas cuadradas de tamaño fijo. Solo se
+// guardan las celdas ocupadas (mapa disperso), así que el coste no depende del
+// tamaño del mapa. update() solo mueve la entidad de celda cuando cruza un
+// borde; si sigue en la misma celda solo actualiza la posición guardada.
+// Las consultas visitan las celdas que tocan el área pedida, de modo que su
+// coste depende de la densidad local y no del número total de entidades.
+// Las distancias se calculan con la posición guardada en el último update().
+// Los nodos de los mapas que se quitan (celdas vacías, entidades retiradas) se
+// guardan y se reutilizan, así que tras el calentamiento insertar, quitar o
+// cambiar de celda no reserva memoria.
+template<typename T>
+class CSpatialHash {
+private:
+    struct Entry {
+        T* item;
+        sf::Vector2f position;
+    };
+
+    struct Location {
+        int64_t cellKey;
+        uint32_t slot;           // Posición dentro del vector de la celda
+    };
+
+    using CellMap = std::unordered_map<int64_t, std::vector<Entry>>;
+    using LocationMap = std::unordered_map<const T*, Location>;
+
+    CellMap cells;
+    LocationMap locations;
+
+    // Nodos sueltos para reutilizar (una celda conserva la capacidad de su vector)
+    std::vector<typename CellMap::node_type> spareCells;
+    std::vector<typename LocationMap::node_type> spareLocations;
+
+    float cellSize;
+    float inverseCellSize;
+
+    // Extensión de las celdas usadas (solo crece hasta clear()): acota la búsqueda sin rango
+    int minCellX, minCellY, maxCellX, maxCellY;
+
+public:
+    explicit CSpatialHash(float cellSize = 64.0f)
+        : cellSize(cellSize), inverseCellSize(1.0f / cellSize) {
+        resetExtents();
+    }
+
+    // Cambia el tamaño de celda y vuelve a repartir todas las entidades
+    void setCellSize(float size) {
+        std::vector<Entry> entries;
+        entries.reserve(locations.size());
+        for (const auto& pair : cells) {
+            entries.insert(entries.end(), pair.second.begin(), pair.second.end());
+        }
+
+        clear();
+        cellSize = size;
+        inverseCellSize = 1.0f / size;
+
+        for (const Entry& entry : entries) {
+            insert(entry.item, entry.position);
+        }
+    }
+
+    float getCellSize() const { return cellSize; }
+
+    // GESTION
+    void insert(T* item, const sf::Vector2f& position) {
+        if (locations.count(item)) {
+            update(item, position);
+            return;
+        }
+
+        Location location;
+        place(item, position, location);
+
+        if (!spareLocations.empty()) {
+            typename LocationMap::node_type node = std::move(spareLocations.back());
+            spareLocations.pop_back();
+            node.key() = item;
+            node.mapped() = location;
+            locations.insert(std::move(node));
+        } else {
+            locations.emplace(item, location);
+        }
+    }
+
+    bool remove(const T* item) {
+        auto it = locations.find(item);
+        if (it == locations.end()) {
+            return false;
+        }
+
+        detach(it->second);
+        spareLocations.push_back(locations.extract(it));
+        return true;
+    }
+
+    void update(T* item, const sf::Vector2f& position) {
+        auto it = locations.find(item);
+        if (it == locations.end()) {
+            insert(item, position);
+            return;
+        }
+
+        Location& location = it->second;
+        if (makeKey(toCell(position.x), toCell(position.y)) == location.cellKey) {
+            cells[location.cellKey][location.slot].position = position;
+            return;
+        }
+
+        // Cambio de celda: sacar de la antigua y meter en la nueva (la entrada de locations se reutiliza)
+        detach(location);
+        place(item, position, location);
+    }
+
+    bool contains(const T* item) const { return locations.count(item) != 0; }
+    size_t size() const { return locations.size(); }
+    size_t getCellCount() const { return cells.size(); }
+
+    void clear() {
+        cells.clear();
+        locations.clear();
+        resetExtents();
+    }
+
+    // CONSULTAS
+    // Elemento más cercano con distancia < maxRange (maxRange <= 0: sin límite)
+    template<typename Filter = SpatialAcceptAll>
+    T* queryNearest(const sf::Vector2f& position, float maxRange = -1.0f,
+                    const Filter& filter = Filter()) const {
+        std::vector<T*> result;
+        queryNearestK(position, 1, maxRange, result, filter);
+        return result.empty() ? nullptr : result.front();
+    }
+
+    // Los k elementos más cercanos con distancia < maxRange, ordenados de menor a mayor distancia
+    template<typename Filter = SpatialAcceptAll>
+    void queryNearestK(const sf::Vector2f& position, size_t k, float maxRange,
+                       std::vector<T*>& out, const Filter& filter = Filter()) const {
+        out.clear();
+        if (k == 0 || locations.empty()) {
+            return;
+        }
+
+        bool bounded = maxRange > 0.0f;
+        float limitSq = bounded ? maxRange * maxRange : 0.0f;
+
+        int centerX = toCell(position.x);
+        int centerY = toCell(position.y);
+
+        // Anillo más lejano que puede contener algo: por rango o por la extensión ocupada
+        int maxRing = std::max(std::max(centerX - minCellX, maxCellX - centerX),
+                               std::max(centerY - minCellY, maxCellY - centerY));
+        if (bounded) {
+            maxRing = std::min(maxRing, static_cast<int>(std::ceil(maxRange * inverseCellSize)));
+        }
+
+        // Mejores candidatos ordenados por distancia al cuadrado
+        std::vector<std::pair<float, T*>> best;
+        best.reserve(k + 1);
+
+        auto consider = [&](const std::vector<Entry>& cell) {
+            for (const Entry& entry : cell) {
+                float dx = entry.position.x - position.x;
+                float dy = entry.position.y - position.y;
+                float distanceSq = dx * dx + dy * dy;
+
+                if (bounded && distanceSq >= limitSq) continue;
+                if (best.size() == k && distanceSq >= best.back().first) continue;
+                if (!filter(entry.item)) continue;
+
+                auto insertAt = std::upper_bound(best.begin(), best.end(), distanceSq,
+                    [](float value, const std::pair<float, T*>& candidate) {
+                        return value < candidate.first;
+                    });
+                best.insert(insertAt, std::make_pair(distanceSq, entry.item));
+                if (best.size() > k) {
+                    best.pop_back();
+                }
+            }
+        };
+
+        int64_t side = 2 * static_cast<int64_t>(maxRing) + 1;
+        if (side * side > static_cast<int64_t>(cells.size())) {
+            // Rejilla dispersa: sale más barato recorrer solo las celdas ocupadas
+            for (const auto& pair : cells) {
+                consider(pair.second);
+            }
+        } else {
+            for (int ring = 0; ring <= maxRing; ring++) {
+                // Todo punto del anillo está al menos a (ring - 1) celdas del punto consultado
+                if (best.size() == k && ring > 1) {
+                    float ringDistance = (ring - 1) * cellSize;
+                    if (ringDistance * ringDistance >= best.back().first) {
+                        break;
+                    }
+                }
+                forEachCellInRing(centerX, centerY, ring, consider);
+            }
+        }
+
+        out.reserve(best.size());
+        for (const auto& candidate : best) {
+            out.push_back(candidate.second);
+        }
+    }
+
+    // Elementos con distancia <= radius (sin orden definido)
+    template<typename Filter = SpatialAcceptAll>
+    void queryRadius(const sf::Vector2f& position, float radius,
+                     std::vector<T*>& out, const Filter& filter = Filter()) const {
+        out.clear();
+        float radiusSq = radius * radius;
+        sf::FloatRect area(position.x - radius, position.y - radius, radius * 2.0f, radius * 2.0f);
+
+        forEachCellInRect(area, [&](const std::vector<Entry>& cell) {
+            for (const Entry& entry : cell) {
+                float dx = entry.position.x - position.x;
+                float dy = entry.position.y - position.y;
+                if (dx * dx + dy * dy <= radiusSq && filter(entry.item)) {
+                    out.push_back(entry.item);
+                }
+            }
+        });
+    }
+
+    // Elementos cuya posición cae dentro del rectángulo (sin orden definido)
+    template<typename Filter = SpatialAcceptAll>
+    void queryRect(const sf::FloatRect& area, std::vector<T*>& out,
+                   const Filter& filter = Filter()) const {
+        out.clear();
+
+        forEachCellInRect(area, [&](const std::vector<Entry>& cell) {
+            for (const Entry& entry : cell) {
+                if (area.contains(entry.position) && filter(entry.item)) {
+                    out.push_back(entry.item);
+                }
+            }
+        });
+    }
+
+private:
+    int toCell(float coordinate) const {
+        return static_cast<int>(std::floor(coordinate * inverseCellSize));
+    }
+
+    static int64_t makeKey(int cellX, int cellY) {
+        return static_cast<int64_t>((static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) |
+                                    static_cast<uint32_t>(cellY));
+    }
+
+    void resetExtents() {
+        minCellX = minCellY = 1 << 30;
+        maxCellX = maxCellY = -(1 << 30);
+    }
+
+    // Mete la entrada en su celda y rellena location; no toca locations
+    void place(T* item, const sf::Vector2f& position, Location& location) {
+        int cellX = toCell(position.x);
+        int cellY = toCell(position.y);
+        int64_t key = makeKey(cellX, cellY);
+
+        std::vector<Entry>& cell = acquireCell(key);
+        location = Location{key, static_cast<uint32_t>(cell.size())};
+        cell.push_back(Entry{item, position});
+
+        minCellX = std::min(minCellX, cellX);
+        minCellY = std::min(minCellY, cellY);
+        maxCellX = std::max(maxCellX, cellX);
+        maxCellY = std::max(maxCellY, cellY);
+    }
+
+    std::vector<Entry>& acquireCell(int64_t key) {
+        auto it = cells.find(key);
+        if (it != cells.end()) {
+            return it->second;
+        }
+
+        if (spareCells.empty()) {
+            return cells[key];
+        }
+
+        typename CellMap::node_type node = std::move(spareCells.back());
+        spareCells.pop_back();
+        node.key() = key;
+        return cells.insert(std::move(node)).position->second;
+    }
+
+    // Quita la entrada de su celda (swap-and-pop) sin tocar locations del propio elemento
+    void detach(const Location& location) {
+        auto cellIt = cells.find(location.cellKey);
+        std::vector<Entry>& cell = cellIt->second;
+
+        uint32_t last = static_cast<uint32_t>(cell.size()) - 1;
+        if (location.slot != last) {
+            cell[location.slot] = cell[last];
+            locations[cell[location.slot].item].slot = location.slot;
+        }
+        cell.pop_back();
+
+        if (cell.empty()) {
+            spareCells.push_back(cells.extract(cellIt));
+        }
+    }
+
+    template<typename Visitor>
+    void visitCell(int cellX, int cellY, Visitor& visitor) const {
+        auto it = cells.find(makeKey(cellX, cellY));
+        if (it != cells.end()) {
+            visitor(it->second);
+        }
+    }
+
+    template<typename Visitor>
+    void forEachCellInRing(int centerX, int centerY, int ring, Visitor visitor) const {
+        if (ring == 0) {
+            visitCell(centerX, centerY, visitor);
+            return;
+        }
+
+        // Filas superior e inferior completas, columnas laterales sin las esquinas
+        for (int x = centerX - ring; x <= centerX + ring; x++) {
+            visitCell(x, centerY - ring, visitor);
+            visitCell(x, centerY + ring, visitor);
+        }
+        for (int y = centerY - ring + 1; y <= centerY + ring - 1; y++) {
+            visitCell(centerX - ring, y, visitor);
+            visitCell(centerX + ring, y, visitor);
+        }
+    }
+
+    template<typename Visitor>
+    void forEachCellInRect(const sf::FloatRect& area, Visitor visitor) const {
+        int startX = std::max(toCell(area.left), minCellX);
+        int startY = std::max(toCell(area.top), minCellY);
+        int endX = std::min(toCell(area.left + area.width), maxCellX);
+        int endY = std::min(toCell(area.top + area.height), maxCellY);
+        if (startX > endX || startY > endY) {
+            return;
+        }
+
+        // Si el área cubre más celdas de las que hay ocupadas, recorrer directamente las ocupadas
+        int64_t areaCells = static_cast<int64_t>(endX - startX + 1) * (endY - startY + 1);
+        if (areaCells > static_cast<int64_t>(cells.size())) {
+            for (const auto& pair : cells) {
+                int cellX = static_cast<int32_t>(static_cast<uint64_t>(pair.first) >> 32);
+                int cellY = static_cast<int32_t>(static_cast<uint32_t>(pair.first));
+                if (cellX >= startX && cellX <= endX && cellY >= startY && cellY <= endY) {
+                    visitor(pair.second);
+                }
+            }
+            return;
+        }
+
+        for (int y = startY; y <= endY; y++) {
+            for (int x = startX; x <= endX; x++) {
+                visitCell(x, y, visitor);
+            }
+        }
+    }
+};
+
+#endif // CSPATIALHASH_HPP
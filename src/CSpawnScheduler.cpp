@@ -0,0 +1,80 @@
+#include "CSpawnScheduler.hpp"
+#include <algorithm>
+#include <limits>
+
+CSpawnScheduler::CSpawnScheduler()
+    : deferredCount(0), pendingSpawns(0) {}
+
+void CSpawnScheduler::clear() {
+    queue.clear();
+    for (std::vector<SpawnEvent>& list : deferred) {
+        list.clear();
+    }
+    deferredCount = 0;
+    pendingSpawns = 0;
+}
+
+void CSpawnScheduler::reserve(size_t spawners) {
+    queue.reserve(spawners);
+}
+
+void CSpawnScheduler::add(uint32_t spawner, float time, uint16_t waveSize, uint16_t firings, float interval) {
+    if (waveSize == 0 || firings == 0) return;
+
+    pendingSpawns += static_cast<size_t>(waveSize) * firings;
+    push(SpawnEvent{time, std::max(interval, 0.0f), spawner, firings, waveSize});
+}
+
+bool CSpawnScheduler::popDue(float now, SpawnEvent& out) {
+    if (queue.empty() || queue.front().time > now) return false;
+
+    std::pop_heap(queue.begin(), queue.end(), laterThan);
+    out = queue.back();
+    queue.pop_back();
+    return true;
+}
+
+void CSpawnScheduler::complete(const SpawnEvent& event) {
+    pendingSpawns -= std::min(pendingSpawns, static_cast<size_t>(event.waveSize));
+
+    if (event.remaining > 1) {
+        SpawnEvent next = event;
+        next.time += event.interval;
+        next.remaining--;
+        push(next);
+    }
+}
+
+void CSpawnScheduler::defer(int chunk, const SpawnEvent& event) {
+    if (chunk < 0) return;
+
+    if (static_cast<size_t>(chunk) >= deferred.size()) {
+        deferred.resize(chunk + 1);
+    }
+    deferred[chunk].push_back(event);
+    deferredCount++;
+}
+
+void CSpawnScheduler::takeDeferred(int chunk, std::vector<SpawnEvent>& out) {
+    out.clear();
+    if (chunk < 0 || static_cast<size_t>(chunk) >= deferred.size()) return;
+
+    // swap: la lista del chunk se queda con la capacidad de out para la próxima vez
+    out.swap(deferred[chunk]);
+    deferredCount -= out.size();
+}
+
+float CSpawnScheduler::getNextTime() const {
+    return queue.empty() ? std::numeric_limits<float>::infinity() : queue.front().time;
+}
+
+// PRIVADOS
+bool CSpawnScheduler::laterThan(const SpawnEvent& a, const SpawnEvent& b) {
+    if (a.time != b.time) return a.time > b.time;
+    return a.spawner > b.spawner;
+}
+
+void CSpawnScheduler::push(const SpawnEvent& event) {
+    queue.push_back(event);
+    std::push_heap(queue.begin(), queue.end(), laterThan);
+}
@@ -0,0 +1,64 @@
+#ifndef CSPAWNSCHEDULER_HPP
+#define CSPAWNSCHEDULER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Próximo disparo de un punto de spawn
+struct SpawnEvent {
+    float time;                  // Segundos desde el inicio del nivel
+    float interval;              // Segundos entre disparos (si quedan más)
+    uint32_t spawner;            // Índice del punto de spawn en CLevel
+    uint16_t remaining;          // Disparos que quedan, contando este
+    uint16_t waveSize;           // Enemigos por disparo
+};
+
+// ===============================================
+// Planificador de spawns (cola por tiempo)
+// ===============================================
+// Un min-heap con el próximo disparo de cada punto de spawn, ordenado por
+// tiempo (y por índice en empate, para spawnear en el orden del nivel). Cada
+// frame solo se sacan los disparos vencidos: si no vence ninguno el coste es
+// mirar la cima, haya los spawns que haya. Un punto que repite vuelve a la
+// cola tras cada disparo con su intervalo. Los disparos que caen en un chunk
+// descargado se aparcan en una lista de ese chunk hasta que se cargue.
+// pendingSpawns lleva la cuenta de enemigos que faltan por salir (en la cola
+// o aparcados) sin recorrer nada.
+class CSpawnScheduler {
+private:
+    std::vector<SpawnEvent> queue;               // Min-heap (std::push_heap con laterThan)
+    std::vector<std::vector<SpawnEvent>> deferred;  // Por chunk
+    size_t deferredCount;
+    size_t pendingSpawns;
+
+public:
+    CSpawnScheduler();
+
+    void clear();
+    void reserve(size_t spawners);
+
+    // Programa todos los disparos de un punto (firings >= 1)
+    void add(uint32_t spawner, float time, uint16_t waveSize, uint16_t firings, float interval);
+
+    // Saca el disparo más temprano si ya ha vencido
+    bool popDue(float now, SpawnEvent& out);
+
+    // Tras disparar: descuenta la oleada y reprograma el siguiente disparo, si lo hay
+    void complete(const SpawnEvent& event);
+
+    // Disparos vencidos en un chunk descargado
+    void defer(int chunk, const SpawnEvent& event);
+    void takeDeferred(int chunk, std::vector<SpawnEvent>& out);
+
+    size_t getPendingSpawns() const { return pendingSpawns; }
+    size_t getQueuedCount() const { return queue.size(); }
+    size_t getDeferredCount() const { return deferredCount; }
+    float getNextTime() const;                   // Infinito si la cola está vacía
+
+private:
+    static bool laterThan(const SpawnEvent& a, const SpawnEvent& b);
+    void push(const SpawnEvent& event);
+};
+
+#endif // CSPAWNSCHEDULER_HPP
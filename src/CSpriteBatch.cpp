@@ -0,0 +1,134 @@
+#include "CSpriteBatch.hpp"
+
+// Constructor
+CSpriteBatch::CSpriteBatch() : activeBatches(0) {
+    resetStats();
+}
+
+// AÑADIR GEOMETRIA
+void CSpriteBatch::draw(const sf::Sprite& sprite) {
+    const sf::Texture* texture = sprite.getTexture();
+    if (!texture) return;
+
+    // Esquinas del rectángulo local transformadas (posición, escala, origen y rotación del sprite)
+    sf::FloatRect local = sprite.getLocalBounds();
+    const sf::Transform& transform = sprite.getTransform();
+    sf::Vector2f corners[4] = {
+        transform.transformPoint(0.0f, 0.0f),
+        transform.transformPoint(local.width, 0.0f),
+        transform.transformPoint(local.width, local.height),
+        transform.transformPoint(0.0f, local.height)
+    };
+
+    const sf::IntRect& textureRect = sprite.getTextureRect();
+    sf::FloatRect texCoords(static_cast<float>(textureRect.left), static_cast<float>(textureRect.top),
+                            static_cast<float>(textureRect.width), static_cast<float>(textureRect.height));
+
+    appendQuad(getBatch(texture), corners, texCoords, sprite.getColor());
+}
+
+void CSpriteBatch::drawQuad(const sf::Texture* texture, const sf::FloatRect& rect,
+                            const sf::IntRect& textureRect, const sf::Color& color) {
+    sf::Vector2f corners[4] = {
+        sf::Vector2f(rect.left, rect.top),
+        sf::Vector2f(rect.left + rect.width, rect.top),
+        sf::Vector2f(rect.left + rect.width, rect.top + rect.height),
+        sf::Vector2f(rect.left, rect.top + rect.height)
+    };
+
+    sf::FloatRect texCoords(static_cast<float>(textureRect.left), static_cast<float>(textureRect.top),
+                            static_cast<float>(textureRect.width), static_cast<float>(textureRect.height));
+
+    appendQuad(getBatch(texture), corners, texCoords, color);
+}
+
+void CSpriteBatch::drawRect(const sf::FloatRect& rect, const sf::Color& color) {
+    drawQuad(nullptr, rect, sf::IntRect(0, 0, 0, 0), color);
+}
+
+void CSpriteBatch::drawRect(const sf::FloatRect& rect, const sf::Color& fillColor,
+                            float outlineThickness, const sf::Color& outlineColor) {
+    // Borde exterior como sf::RectangleShape: un quad más grande debajo del relleno
+    if (outlineThickness > 0.0f) {
+        sf::FloatRect outline(rect.left - outlineThickness, rect.top - outlineThickness,
+                              rect.width + outlineThickness * 2.0f, rect.height + outlineThickness * 2.0f);
+        drawRect(outline, outlineColor);
+    }
+    drawRect(rect, fillColor);
+}
+
+// ENVIO
+void CSpriteBatch::flush(sf::RenderTarget& target) {
+    for (size_t i = 0; i < activeBatches; i++) {
+        Batch& batch = batches[i];
+        size_t vertexCount = batch.vertices.getVertexCount();
+        if (vertexCount == 0) continue;
+
+        sf::RenderStates states;
+        states.texture = batch.texture;
+        target.draw(batch.vertices, states);
+
+        stats.drawCalls++;
+        stats.vertices += vertexCount;
+        stats.quads += vertexCount / 4;
+    }
+
+    clear();
+}
+
+void CSpriteBatch::clear() {
+    // clear() de sf::VertexArray mantiene la capacidad reservada
+    for (size_t i = 0; i < activeBatches; i++) {
+        batches[i].vertices.clear();
+    }
+    activeBatches = 0;
+}
+
+// ESTADISTICAS
+void CSpriteBatch::resetStats() {
+    stats.drawCalls = 0;
+    stats.vertices = 0;
+    stats.quads = 0;
+}
+
+const SpriteBatchStats& CSpriteBatch::getStats() const {
+    return stats;
+}
+
+size_t CSpriteBatch::getPendingQuads() const {
+    size_t quads = 0;
+    for (size_t i = 0; i < activeBatches; i++) {
+        quads += batches[i].vertices.getVertexCount() / 4;
+    }
+    return quads;
+}
+
+// METODOS PRIVADOS
+CSpriteBatch::Batch& CSpriteBatch::getBatch(const sf::Texture* texture) {
+    // Pocas texturas por capa: la búsqueda lineal es más barata que un mapa
+    for (size_t i = 0; i < activeBatches; i++) {
+        if (batches[i].texture == texture) {
+            return batches[i];
+        }
+    }
+
+    if (activeBatches == batches.size()) {
+        batches.push_back(Batch{texture, sf::VertexArray(sf::Quads)});
+    }
+
+    Batch& batch = batches[activeBatches++];
+    batch.texture = texture;
+    batch.vertices.setPrimitiveType(sf::Quads);
+    return batch;
+}
+
+void CSpriteBatch::appendQuad(Batch& batch, const sf::Vector2f corners[4], const sf::FloatRect& texCoords,
+                              const sf::Color& color) {
+    float right = texCoords.left + texCoords.width;
+    float bottom = texCoords.top + texCoords.height;
+
+    batch.vertices.append(sf::Vertex(corners[0], color, sf::Vector2f(texCoords.left, texCoords.top)));
+    batch.vertices.append(sf::Vertex(corners[1], color, sf::Vector2f(right, texCoords.top)));
+    batch.vertices.append(sf::Vertex(corners[2], color, sf::Vector2f(right, bottom)));
+    batch.vertices.append(sf::Vertex(corners[3], color, sf::Vector2f(texCoords.left, bottom)));
+}
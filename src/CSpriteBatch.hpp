@@ -0,0 +1,61 @@
+#ifndef CSPRITEBATCH_HPP
+#define CSPRITEBATCH_HPP
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Contadores acumulados desde el último resetStats()
+struct SpriteBatchStats {
+    size_t drawCalls;       // Llamadas a RenderTarget::draw
+    size_t vertices;        // Vértices enviados
+    size_t quads;           // Sprites/rectángulos agrupados
+};
+
+// ===============================================
+// Renderizador 2D por lotes
+// ===============================================
+// Agrupa quads con textura en un sf::VertexArray por textura (página de atlas)
+// y los envía con una sola llamada a draw por textura en flush(). Los quads
+// sin textura (rectángulos de respaldo) forman su propio lote. Dentro de un
+// lote se respeta el orden de llegada; entre lotes, el orden en que apareció
+// cada textura por primera vez. Para separar capas (fondo, plataformas,
+// enemigos...) basta con hacer flush() entre una y otra.
+class CSpriteBatch {
+private:
+    struct Batch {
+        const sf::Texture* texture;
+        sf::VertexArray vertices;
+    };
+
+    // Los lotes se conservan entre frames para reutilizar la memoria de los vértices
+    std::vector<Batch> batches;
+    size_t activeBatches;
+    SpriteBatchStats stats;
+
+public:
+    CSpriteBatch();
+
+    // Añadir geometría
+    void draw(const sf::Sprite& sprite);
+    void drawQuad(const sf::Texture* texture, const sf::FloatRect& rect,
+                  const sf::IntRect& textureRect, const sf::Color& color = sf::Color::White);
+    void drawRect(const sf::FloatRect& rect, const sf::Color& color);
+    void drawRect(const sf::FloatRect& rect, const sf::Color& fillColor,
+                  float outlineThickness, const sf::Color& outlineColor);
+
+    // Enviar todos los lotes pendientes (una llamada a draw por textura) y vaciarlos
+    void flush(sf::RenderTarget& target);
+    void clear();
+
+    // Estadísticas
+    void resetStats();
+    const SpriteBatchStats& getStats() const;
+    size_t getPendingQuads() const;
+
+private:
+    Batch& getBatch(const sf::Texture* texture);
+    void appendQuad(Batch& batch, const sf::Vector2f corners[4], const sf::FloatRect& texCoords,
+                    const sf::Color& color);
+};
+
+#endif // CSPRITEBATCH_HPP
@@ -0,0 +1,119 @@
+#ifndef CSTATICGRID_HPP
+#define CSTATICGRID_HPP
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// ===============================================
+// Rejilla uniforme de rectángulos estáticos
+// ===============================================
+// Complemento de CSpatialHash para geometría que no se mueve (plataformas):
+// cada elemento se guarda por índice en todas las celdas que toca su
+// rectángulo, así que uno muy ancho (el suelo) aparece en varias celdas. La
+// rejilla es densa y cubre los límites del nivel; lo que quede fuera cae en las
+// celdas del borde. query() solo visita las celdas del área pedida y devuelve
+// cada índice una vez, en orden creciente (el orden en que se insertaron si se
+// numeran en orden), para no alterar el orden de dibujado.
+class CStaticGrid {
+private:
+    std::vector<std::vector<uint32_t>> cells;  // columns * rows, por filas
+    std::vector<uint32_t> stamps;              // Última consulta que devolvió cada índice
+    uint32_t queryStamp;
+
+    sf::Vector2f origin;
+    float cellSize;
+    float inverseCellSize;
+    int columns;
+    int rows;
+
+public:
+    explicit CStaticGrid(float cellSize = 256.0f)
+        : queryStamp(0), origin(0.0f, 0.0f), cellSize(cellSize), inverseCellSize(1.0f / cellSize),
+          columns(0), rows(0) {}
+
+    // Vacía la rejilla y la dimensiona para cubrir bounds
+    void reset(const sf::FloatRect& bounds) {
+        origin = sf::Vector2f(bounds.left, bounds.top);
+        columns = std::max(1, static_cast<int>(std::ceil(bounds.width * inverseCellSize)));
+        rows = std::max(1, static_cast<int>(std::ceil(bounds.height * inverseCellSize)));
+
+        cells.assign(static_cast<size_t>(columns) * rows, std::vector<uint32_t>());
+        stamps.clear();
+        queryStamp = 0;
+    }
+
+    void clear() {
+        for (std::vector<uint32_t>& cell : cells) {
+            cell.clear();
+        }
+        stamps.clear();
+        queryStamp = 0;
+    }
+
+    void insert(uint32_t item, const sf::FloatRect& rect) {
+        if (cells.empty()) return;
+
+        if (item >= stamps.size()) {
+            stamps.resize(item + 1, 0);
+        }
+
+        int minX, minY, maxX, maxY;
+        toCellRange(rect, minX, minY, maxX, maxY);
+        for (int y = minY; y <= maxY; y++) {
+            for (int x = minX; x <= maxX; x++) {
+                cells[static_cast<size_t>(y) * columns + x].push_back(item);
+            }
+        }
+    }
+
+    // Índices cuyas celdas tocan el área (conservador: puede incluir alguno que no la corte)
+    void query(const sf::FloatRect& area, std::vector<uint32_t>& out) {
+        out.clear();
+        if (cells.empty()) return;
+
+        // Nueva marca por consulta; al dar la vuelta se limpian todas
+        if (++queryStamp == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            queryStamp = 1;
+        }
+
+        int minX, minY, maxX, maxY;
+        toCellRange(area, minX, minY, maxX, maxY);
+        for (int y = minY; y <= maxY; y++) {
+            for (int x = minX; x <= maxX; x++) {
+                for (uint32_t item : cells[static_cast<size_t>(y) * columns + x]) {
+                    if (stamps[item] != queryStamp) {
+                        stamps[item] = queryStamp;
+                        out.push_back(item);
+                    }
+                }
+            }
+        }
+
+        std::sort(out.begin(), out.end());
+    }
+
+    float getCellSize() const { return cellSize; }
+    size_t getCellCount() const { return cells.size(); }
+
+private:
+    void toCellRange(const sf::FloatRect& rect, int& minX, int& minY, int& maxX, int& maxY) const {
+        minX = clampColumn(std::floor((rect.left - origin.x) * inverseCellSize));
+        maxX = clampColumn(std::floor((rect.left + rect.width - origin.x) * inverseCellSize));
+        minY = clampRow(std::floor((rect.top - origin.y) * inverseCellSize));
+        maxY = clampRow(std::floor((rect.top + rect.height - origin.y) * inverseCellSize));
+    }
+
+    int clampColumn(float cell) const {
+        return static_cast<int>(std::min(std::max(cell, 0.0f), static_cast<float>(columns - 1)));
+    }
+
+    int clampRow(float cell) const {
+        return static_cast<int>(std::min(std::max(cell, 0.0f), static_cast<float>(rows - 1)));
+    }
+};
+
+#endif // CSTATICGRID_HPP
@@ -0,0 +1,296 @@
+#include "CTextureAtlas.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <tuple>
+
+namespace {
+    // Frame único a empaquetar: hoja de origen y rectángulo dentro de ella
+    struct PackItem {
+        size_t sheet;
+        sf::IntRect source;
+        unsigned page;
+        unsigned x;
+        unsigned y;
+        bool placed;
+    };
+}
+
+// Constructor
+CTextureAtlas::CTextureAtlas() : memoryBytes(0), built(false) {
+}
+
+CTextureAtlas& CTextureAtlas::getInstance() {
+    static CTextureAtlas instance;
+    return instance;
+}
+
+// REGISTRO
+void CTextureAtlas::addSheet(const std::string& path, const std::vector<AtlasStripDef>& sheetStrips) {
+    SheetDef* sheet = nullptr;
+    for (auto& existing : sheets) {
+        if (existing.path == path) {
+            sheet = &existing;
+            break;
+        }
+    }
+    if (!sheet) {
+        sheets.push_back(SheetDef{path, {}});
+        sheet = &sheets.back();
+    }
+
+    for (const auto& strip : sheetStrips) {
+        bool known = std::any_of(sheet->strips.begin(), sheet->strips.end(),
+            [&strip](const AtlasStripDef& other) { return other.name == strip.name; });
+        if (!known) {
+            sheet->strips.push_back(strip);
+        }
+    }
+}
+
+// CONSTRUCCION
+bool CTextureAtlas::build() {
+    pages.clear();
+    frames.clear();
+    framePages.clear();
+    strips.clear();
+    memoryBytes = 0;
+    built = false;
+
+    // 1. Cargar hojas y recopilar frames únicos (el mismo rectángulo de la misma hoja se comparte)
+    std::vector<sf::Image> images(sheets.size());
+    std::vector<bool> loadedSheets(sheets.size(), false);
+    std::vector<PackItem> items;
+    std::map<std::tuple<size_t, int, int, int, int>, size_t> itemIndex;
+
+    for (size_t s = 0; s < sheets.size(); s++) {
+        if (!images[s].loadFromFile(sheets[s].path)) {
+            std::cerr << "Error: Atlas: no se pudo cargar " << sheets[s].path << std::endl;
+            continue;
+        }
+        loadedSheets[s] = true;
+
+        for (const auto& strip : sheets[s].strips) {
+            for (int f = 0; f < strip.frameCount; f++) {
+                sf::IntRect source(strip.startX + f * strip.frameWidth, strip.startY, strip.frameWidth, strip.frameHeight);
+                auto key = std::make_tuple(s, source.left, source.top, source.width, source.height);
+                if (itemIndex.find(key) == itemIndex.end()) {
+                    itemIndex[key] = items.size();
+                    items.push_back(PackItem{s, source, 0, 0, 0, false});
+                }
+            }
+        }
+    }
+
+    if (items.empty()) {
+        return false;
+    }
+
+    // 2. Empaquetado por estantes: de más alto a más bajo, de izquierda a derecha
+    std::vector<size_t> order(items.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&items](size_t a, size_t b) {
+        if (items[a].source.height != items[b].source.height) {
+            return items[a].source.height > items[b].source.height;
+        }
+        return items[a].source.width > items[b].source.width;
+    });
+
+    unsigned maxHeight = std::min(MAX_PAGE_HEIGHT, sf::Texture::getMaximumSize());
+    unsigned maxWidth = std::min(PAGE_WIDTH, sf::Texture::getMaximumSize());
+    std::vector<sf::Vector2u> pageSizes(1, sf::Vector2u(0, 0));
+    unsigned cursorX = 0, cursorY = 0, shelfHeight = 0;
+
+    for (size_t index : order) {
+        PackItem& item = items[index];
+        unsigned width = static_cast<unsigned>(item.source.width);
+        unsigned height = static_cast<unsigned>(item.source.height);
+        if (width > maxWidth || height > maxHeight) {
+            std::cerr << "Aviso: Atlas: frame demasiado grande en " << sheets[item.sheet].path << std::endl;
+            continue;
+        }
+
+        if (cursorX + width > maxWidth) {
+            cursorX = 0;
+            cursorY += shelfHeight + PADDING;
+            shelfHeight = 0;
+        }
+        if (cursorY + height > maxHeight) {
+            pageSizes.push_back(sf::Vector2u(0, 0));
+            cursorX = cursorY = shelfHeight = 0;
+        }
+
+        item.page = static_cast<unsigned>(pageSizes.size() - 1);
+        item.x = cursorX;
+        item.y = cursorY;
+        item.placed = true;
+
+        sf::Vector2u& pageSize = pageSizes.back();
+        pageSize.x = std::max(pageSize.x, cursorX + width);
+        pageSize.y = std::max(pageSize.y, cursorY + height);
+
+        cursorX += width + PADDING;
+        shelfHeight = std::max(shelfHeight, height);
+    }
+
+    // 3. Componer cada página en CPU y subirla a la GPU una sola vez
+    std::vector<sf::Image> pageImages(pageSizes.size());
+    for (size_t p = 0; p < pageSizes.size(); p++) {
+        pageImages[p].create(std::max(pageSizes[p].x, 1u), std::max(pageSizes[p].y, 1u), sf::Color::Transparent);
+    }
+    for (const PackItem& item : items) {
+        if (item.placed) {
+            // copy() recorta el rectángulo a la imagen de origen: lo que sobresale queda transparente
+            pageImages[item.page].copy(images[item.sheet], item.x, item.y, item.source);
+        }
+    }
+
+    for (size_t p = 0; p < pageImages.size(); p++) {
+        auto texture = std::make_unique<sf::Texture>();
+        if (!texture->loadFromImage(pageImages[p])) {
+            std::cerr << "Error: Atlas: no se pudo crear la pagina " << p << std::endl;
+            pages.clear();
+            return false;
+        }
+        sf::Vector2u size = texture->getSize();
+        memoryBytes += static_cast<size_t>(size.x) * size.y * 4;
+        pages.push_back(std::move(texture));
+    }
+
+    // 4. Tabla de frames: cada tira apunta a frames consecutivos
+    for (size_t s = 0; s < sheets.size(); s++) {
+        if (!loadedSheets[s]) continue;
+
+        for (const auto& strip : sheets[s].strips) {
+            std::vector<AtlasFrame> stripFrames;
+            std::vector<unsigned> stripPages;
+            bool complete = true;
+
+            for (int f = 0; f < strip.frameCount && complete; f++) {
+                auto key = std::make_tuple(s, strip.startX + f * strip.frameWidth, strip.startY, strip.frameWidth, strip.frameHeight);
+                const PackItem& item = items[itemIndex[key]];
+                if (!item.placed) {
+                    complete = false;
+                    break;
+                }
+                sf::IntRect rect(static_cast<int>(item.x), static_cast<int>(item.y), item.source.width, item.source.height);
+                stripFrames.push_back(AtlasFrame{pages[item.page].get(), rect});
+                stripPages.push_back(item.page);
+            }
+
+            // Las tiras incompletas no se publican: la entidad usará la hoja original
+            if (!complete || stripFrames.empty()) continue;
+
+            strips[strip.name] = StripEntry{frames.size(), static_cast<int>(stripFrames.size())};
+            frames.insert(frames.end(), stripFrames.begin(), stripFrames.end());
+            framePages.insert(framePages.end(), stripPages.begin(), stripPages.end());
+        }
+    }
+
+    built = !strips.empty();
+    return built;
+}
+
+bool CTextureAtlas::isBuilt() const {
+    return built;
+}
+
+void CTextureAtlas::clear() {
+    sheets.clear();
+    pages.clear();
+    frames.clear();
+    framePages.clear();
+    strips.clear();
+    memoryBytes = 0;
+    built = false;
+}
+
+// CONSULTAS
+bool CTextureAtlas::hasStrip(const std::string& name) const {
+    return strips.find(name) != strips.end();
+}
+
+int CTextureAtlas::getFrameCount(const std::string& name) const {
+    auto it = strips.find(name);
+    return it != strips.end() ? it->second.frameCount : 0;
+}
+
+bool CTextureAtlas::getStripFrames(const std::string& name, std::vector<AtlasFrame>& out) const {
+    out.clear();
+    auto it = strips.find(name);
+    if (it == strips.end()) {
+        return false;
+    }
+
+    auto first = frames.begin() + static_cast<std::ptrdiff_t>(it->second.firstFrame);
+    out.assign(first, first + it->second.frameCount);
+    return true;
+}
+
+void CTextureAtlas::sliceStrip(const sf::Texture* texture, const AtlasStripDef& strip, std::vector<AtlasFrame>& out) {
+    out.clear();
+    if (!texture) return;
+
+    for (int f = 0; f < strip.frameCount; f++) {
+        out.push_back(AtlasFrame{texture, sf::IntRect(strip.startX + f * strip.frameWidth, strip.startY,
+                                                      strip.frameWidth, strip.frameHeight)});
+    }
+}
+
+// INFORMACION Y VOLCADO
+size_t CTextureAtlas::getPageCount() const {
+    return pages.size();
+}
+
+size_t CTextureAtlas::getMemoryBytes() const {
+    return memoryBytes;
+}
+
+bool CTextureAtlas::writeFrameTable(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: No se pudo escribir " << path << std::endl;
+        return false;
+    }
+
+    // Orden alfabético para que el archivo sea estable entre ejecuciones
+    std::map<std::string, StripEntry> sorted(strips.begin(), strips.end());
+
+    file << "# tira frame pagina x y ancho alto" << std::endl;
+    for (const auto& pair : sorted) {
+        for (int f = 0; f < pair.second.frameCount; f++) {
+            size_t index = pair.second.firstFrame + f;
+            const sf::IntRect& rect = frames[index].rect;
+            file << pair.first << " " << f << " " << framePages[index] << " "
+                 << rect.left << " " << rect.top << " " << rect.width << " " << rect.height << std::endl;
+        }
+    }
+    return true;
+}
+
+bool CTextureAtlas::savePages(const std::string& pathPrefix) const {
+    bool ok = true;
+    for (size_t p = 0; p < pages.size(); p++) {
+        std::string path = pathPrefix + std::to_string(p) + ".png";
+        if (!pages[p]->copyToImage().saveToFile(path)) {
+            std::cerr << "Error: No se pudo escribir " << path << std::endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+void CTextureAtlas::printStats() const {
+    std::cout << "=== Atlas de Texturas ===" << std::endl;
+    std::cout << "  Paginas: " << pages.size() << " | Tiras: " << strips.size()
+              << " | Frames: " << frames.size() << std::endl;
+    for (size_t p = 0; p < pages.size(); p++) {
+        sf::Vector2u size = pages[p]->getSize();
+        std::cout << "  Pagina " << p << ": " << size.x << "x" << size.y << std::endl;
+    }
+    std::cout << "  Memoria estimada: " << (memoryBytes / 1024) << " KB" << std::endl;
+    std::cout << "=========================" << std::endl;
+}
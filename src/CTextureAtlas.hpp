@@ -0,0 +1,94 @@
+#ifndef CTEXTUREATLAS_HPP
+#define CTEXTUREATLAS_HPP
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Tira de frames dentro de una hoja de sprites: frameCount frames de
+// frameWidth x frameHeight colocados en horizontal a partir de (startX, startY)
+struct AtlasStripDef {
+    std::string name;        // Nombre único en el atlas (p. ej. "zombie.moving")
+    int startX;
+    int startY;
+    int frameCount;
+    int frameWidth;
+    int frameHeight;
+};
+
+// Frame resuelto: textura (página del atlas u hoja original) y rectángulo dentro de ella
+struct AtlasFrame {
+    const sf::Texture* texture;
+    sf::IntRect rect;
+};
+
+// ===============================================
+// Atlas de texturas construido al arrancar
+// ===============================================
+// Las entidades registran sus hojas de sprites (ruta + tiras de frames) y
+// build() recorta cada frame, lo empaqueta por estantes en una o pocas páginas
+// y sube solo esas páginas a la GPU. La tabla de frames (nombre de tira ->
+// página + rectángulo) sustituye a las coordenadas fijas de cada clase; los
+// frames repetidos en varias tiras se guardan una sola vez. Como todo queda
+// en pocas texturas, CSpriteBatch puede dibujar todos los enemigos con una o
+// dos llamadas a draw.
+class CTextureAtlas {
+public:
+    static const unsigned PAGE_WIDTH = 1024;
+    static const unsigned MAX_PAGE_HEIGHT = 2048;
+    static const unsigned PADDING = 2;         // Separación entre frames (evita sangrado al filtrar)
+
+private:
+    struct SheetDef {
+        std::string path;
+        std::vector<AtlasStripDef> strips;
+    };
+
+    struct StripEntry {
+        size_t firstFrame;
+        int frameCount;
+    };
+
+    std::vector<SheetDef> sheets;
+    std::vector<std::unique_ptr<sf::Texture>> pages;
+    std::vector<AtlasFrame> frames;
+    std::vector<unsigned> framePages;                    // Página de cada frame (para la tabla)
+    std::unordered_map<std::string, StripEntry> strips;
+    size_t memoryBytes;
+    bool built;
+
+    CTextureAtlas();
+
+public:
+    CTextureAtlas(const CTextureAtlas&) = delete;
+    CTextureAtlas& operator=(const CTextureAtlas&) = delete;
+
+    static CTextureAtlas& getInstance();
+
+    // Registro (antes de build). Registrar dos veces la misma tira no la duplica
+    void addSheet(const std::string& path, const std::vector<AtlasStripDef>& sheetStrips);
+
+    // Construcción: false si no se pudo empaquetar ninguna hoja
+    bool build();
+    bool isBuilt() const;
+    void clear();
+
+    // Consultas
+    bool hasStrip(const std::string& name) const;
+    int getFrameCount(const std::string& name) const;    // 0 si la tira no existe
+    bool getStripFrames(const std::string& name, std::vector<AtlasFrame>& out) const;
+
+    // Frames de una tira tomados de una textura suelta (sin atlas)
+    static void sliceStrip(const sf::Texture* texture, const AtlasStripDef& strip, std::vector<AtlasFrame>& out);
+
+    // Información y volcado
+    size_t getPageCount() const;
+    size_t getMemoryBytes() const;
+    bool writeFrameTable(const std::string& path) const;       // Texto: tira frame página x y ancho alto
+    bool savePages(const std::string& pathPrefix) const;       // <prefijo>0.png, <prefijo>1.png...
+    void printStats() const;
+};
+
+#endif // CTEXTUREATLAS_HPP
@@ -0,0 +1,171 @@
+#include "CTextureCache.hpp"
+#include <iostream>
+
+// Constructor
+CTextureCache::CTextureCache()
+    : hits(0), misses(0), failedLoads(0), memoryBytes(0), loadingEnabled(true) {
+}
+
+CTextureCache& CTextureCache::getInstance() {
+    static CTextureCache instance;
+    return instance;
+}
+
+// OBTENER TEXTURA
+TextureHandle CTextureCache::acquire(const std::string& path) {
+    // Sin carga de texturas las entidades usan su representacion de respaldo
+    if (!loadingEnabled) {
+        return nullptr;
+    }
+
+    auto it = textures.find(path);
+    if (it != textures.end()) {
+        // Las cargas fallidas tambien se recuerdan (nullptr) para no reintentar en cada spawn
+        hits++;
+        return it->second;
+    }
+
+    misses++;
+
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromFile(path)) {
+        std::cerr << "Error: No se pudo cargar " << path << std::endl;
+        failedLoads++;
+        textures.emplace(path, nullptr);
+        return nullptr;
+    }
+
+    memoryBytes += estimateTextureBytes(*texture);
+    textures.emplace(path, texture);
+
+    return texture;
+}
+
+TextureHandle CTextureCache::insert(const std::string& path, const sf::Image& image) {
+    if (!loadingEnabled) {
+        return nullptr;
+    }
+
+    // Si ya estaba residente se conserva la existente (los handles repartidos siguen siendo válidos)
+    auto it = textures.find(path);
+    if (it != textures.end() && it->second) {
+        hits++;
+        return it->second;
+    }
+
+    // Cuenta como fallo: el archivo se leyó del disco, aunque fuera en otro hilo
+    misses++;
+
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromImage(image)) {
+        std::cerr << "Error: No se pudo subir " << path << " a la GPU" << std::endl;
+        failedLoads++;
+        textures[path] = nullptr;
+        return nullptr;
+    }
+
+    memoryBytes += estimateTextureBytes(*texture);
+    textures[path] = texture;
+
+    return texture;
+}
+
+// CONSULTAS
+bool CTextureCache::contains(const std::string& path) const {
+    auto it = textures.find(path);
+    return it != textures.end() && it->second != nullptr;
+}
+
+long CTextureCache::getReferenceCount(const std::string& path) const {
+    auto it = textures.find(path);
+    if (it == textures.end() || !it->second) {
+        return 0;
+    }
+
+    // Restar la referencia que mantiene el propio cache
+    return it->second.use_count() - 1;
+}
+
+std::vector<std::string> CTextureCache::getResidentPaths() const {
+    std::vector<std::string> paths;
+    for (const auto& pair : textures) {
+        if (pair.second) {
+            paths.push_back(pair.first);
+        }
+    }
+    return paths;
+}
+
+TextureCacheStats CTextureCache::getStats() const {
+    TextureCacheStats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    stats.failedLoads = failedLoads;
+    stats.textureCount = 0;
+    stats.memoryBytes = memoryBytes;
+
+    for (const auto& pair : textures) {
+        if (pair.second) {
+            stats.textureCount++;
+        }
+    }
+
+    return stats;
+}
+
+// MODO HEADLESS
+void CTextureCache::setLoadingEnabled(bool enabled) {
+    loadingEnabled = enabled;
+}
+
+bool CTextureCache::isLoadingEnabled() const {
+    return loadingEnabled;
+}
+
+// LIBERACION
+size_t CTextureCache::purgeUnused() {
+    size_t released = 0;
+
+    for (auto it = textures.begin(); it != textures.end();) {
+        if (it->second && it->second.use_count() == 1) {
+            memoryBytes -= estimateTextureBytes(*it->second);
+            it = textures.erase(it);
+            released++;
+        } else {
+            ++it;
+        }
+    }
+
+    return released;
+}
+
+void CTextureCache::clear() {
+    textures.clear();
+    memoryBytes = 0;
+}
+
+// DEBUG
+void CTextureCache::printStats() const {
+    TextureCacheStats stats = getStats();
+
+    std::cout << "=== Cache de Texturas ===" << std::endl;
+    std::cout << "  Texturas residentes: " << stats.textureCount << std::endl;
+    std::cout << "  Memoria estimada: " << (stats.memoryBytes / 1024) << " KB" << std::endl;
+    std::cout << "  Aciertos: " << stats.hits << " | Fallos: " << stats.misses
+              << " | Cargas fallidas: " << stats.failedLoads << std::endl;
+
+    for (const auto& pair : textures) {
+        if (pair.second) {
+            std::cout << "  " << pair.first << " (" << pair.second->getSize().x << "x"
+                      << pair.second->getSize().y << ", refs: " << (pair.second.use_count() - 1) << ")" << std::endl;
+        }
+    }
+
+    std::cout << "=========================" << std::endl;
+}
+
+// METODOS PRIVADOS
+size_t CTextureCache::estimateTextureBytes(const sf::Texture& texture) {
+    sf::Vector2u size = texture.getSize();
+    return static_cast<size_t>(size.x) * static_cast<size_t>(size.y) * 4;
+}
@@ -0,0 +1,74 @@
+#ifndef CTEXTURECACHE_HPP
+#define CTEXTURECACHE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Textura compartida: todas las instancias que piden el mismo archivo reciben el mismo sf::Texture
+using TextureHandle = std::shared_ptr<const sf::Texture>;
+
+// Contadores del cache (para debug y benchmarks)
+struct TextureCacheStats {
+    size_t hits;            // Peticiones servidas sin tocar el disco
+    size_t misses;          // Peticiones que tuvieron que cargar el archivo
+    size_t failedLoads;     // Archivos que no se pudieron cargar
+    size_t textureCount;    // Texturas residentes
+    size_t memoryBytes;     // Memoria estimada en GPU (RGBA8)
+};
+
+// ===============================================
+// Cache central de texturas indexado por ruta
+// ===============================================
+// Cada archivo se decodifica y se sube a la GPU una sola vez. Las entidades
+// guardan un TextureHandle (conteo de referencias) en lugar de su propio sf::Texture.
+class CTextureCache {
+private:
+    // El cache mantiene una referencia fuerte: la textura sigue residente aunque
+    // no quede ninguna entidad usándola, así los siguientes spawns no vuelven a cargarla
+    std::unordered_map<std::string, std::shared_ptr<sf::Texture>> textures;
+
+    size_t hits;
+    size_t misses;
+    size_t failedLoads;
+    size_t memoryBytes;
+    bool loadingEnabled;     // false en modo headless: no se decodifica ni se sube nada a la GPU
+
+    CTextureCache();
+
+public:
+    CTextureCache(const CTextureCache&) = delete;
+    CTextureCache& operator=(const CTextureCache&) = delete;
+
+    static CTextureCache& getInstance();
+
+    // Obtener textura (la carga la primera vez). Devuelve nullptr si el archivo no existe
+    TextureHandle acquire(const std::string& path);
+
+    // Subir una imagen ya decodificada (p. ej. en un hilo de carga). Solo desde el hilo principal
+    TextureHandle insert(const std::string& path, const sf::Image& image);
+
+    // Consultas
+    bool contains(const std::string& path) const;
+    long getReferenceCount(const std::string& path) const;  // Referencias externas (sin contar el cache)
+    std::vector<std::string> getResidentPaths() const;
+    TextureCacheStats getStats() const;
+
+    // Modo headless (sin dispositivo gráfico)
+    void setLoadingEnabled(bool enabled);
+    bool isLoadingEnabled() const;
+
+    // Liberación
+    size_t purgeUnused();                        // Libera las texturas que nadie más usa
+    void clear();
+
+    // Debug
+    void printStats() const;
+
+private:
+    static size_t estimateTextureBytes(const sf::Texture& texture);
+};
+
+#endif // CTEXTURECACHE_HPP
@@ -0,0 +1,177 @@
+#include "CTraceWriter.hpp"
+#include <iostream>
+#include <cstdio>
+#include <algorithm>
+
+namespace {
+    thread_local uint32_t currentThreadId = 0;    // 0 = sin asignar
+    thread_local const char* currentThreadName = nullptr;
+    thread_local uint32_t threadNameSession = 0;  // Traza en la que ya se escribió el nombre
+}
+
+// Constructor
+CTraceWriter::CTraceWriter()
+    : active(false), stopRequested(false), firstEvent(true), eventsWritten(0), nextThreadId(1), session(0) {
+}
+
+CTraceWriter::~CTraceWriter() {
+    stop();
+}
+
+// CONTROL
+bool CTraceWriter::start(const std::string& outputPath) {
+    if (active) {
+        stop();
+    }
+
+    file.open(outputPath);
+    if (!file.is_open()) {
+        std::cerr << "CTraceWriter: No se pudo crear " << outputPath << std::endl;
+        return false;
+    }
+
+    path = outputPath;
+    origin = Clock::now();
+    firstEvent = true;
+    eventsWritten = 0;
+    stopRequested = false;
+    pending.reserve(FLUSH_THRESHOLD * 2);
+    writing.reserve(FLUSH_THRESHOLD * 2);
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    session.fetch_add(1, std::memory_order_relaxed);
+    flushThread = std::thread(&CTraceWriter::flushLoop, this);
+    active.store(true, std::memory_order_release);
+    setThreadName("main");
+
+    std::cout << "CTraceWriter: Grabando traza en " << path << std::endl;
+    return true;
+}
+
+void CTraceWriter::stop() {
+    if (!active) return;
+
+    active.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    flushSignal.notify_one();
+    if (flushThread.joinable()) {
+        flushThread.join();
+    }
+
+    file << "\n]}\n";
+    file.close();
+
+    std::cout << "CTraceWriter: " << eventsWritten << " eventos escritos en " << path << std::endl;
+}
+
+// REGISTRO
+void CTraceWriter::record(const char* name, Clock::time_point begin, Clock::time_point end) {
+    // Hilo nombrado antes de esta traza: su nombre va delante de su primer evento
+    if (currentThreadName && threadNameSession != session.load(std::memory_order_relaxed)) {
+        recordThreadName();
+    }
+
+    TraceEvent event;
+    event.name = name;
+    event.startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - origin).count();
+    event.durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    event.threadId = getCurrentThreadId();
+    event.phase = 'X';
+    push(event);
+}
+
+void CTraceWriter::setThreadName(const char* name) {
+    if (currentThreadName == name && threadNameSession == session.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    currentThreadName = name;
+    threadNameSession = 0;
+    if (isActive()) {
+        recordThreadName();
+    }
+}
+
+void CTraceWriter::recordThreadName() {
+    threadNameSession = session.load(std::memory_order_relaxed);
+    push(TraceEvent{currentThreadName, 0, 0, getCurrentThreadId(), 'M'});
+}
+
+void CTraceWriter::push(const TraceEvent& event) {
+    bool flushNow = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(event);
+        flushNow = pending.size() >= FLUSH_THRESHOLD;
+    }
+
+    if (flushNow) {
+        flushSignal.notify_one();
+    }
+}
+
+uint32_t CTraceWriter::getCurrentThreadId() {
+    if (currentThreadId == 0) {
+        currentThreadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    }
+    return currentThreadId;
+}
+
+// HILO DE VOLCADO
+void CTraceWriter::flushLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        flushSignal.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS), [this]() {
+            return stopRequested || pending.size() >= FLUSH_THRESHOLD;
+        });
+
+        // Intercambiar buffers: los productores siguen escribiendo en uno vacío
+        writing.clear();
+        writing.swap(pending);
+        bool stopping = stopRequested;
+
+        lock.unlock();
+        writeEvents(writing);
+        lock.lock();
+
+        if (stopping && pending.empty()) {
+            break;
+        }
+    }
+}
+
+void CTraceWriter::writeEvents(const std::vector<TraceEvent>& events) {
+    char line[256];
+
+    for (const TraceEvent& event : events) {
+        const char* separator = firstEvent ? "" : ",\n";
+        int length;
+        if (event.phase == 'M') {
+            length = std::snprintf(line, sizeof(line),
+                "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                separator, event.threadId, event.name);
+        } else {
+            // Chrome espera microsegundos; se conservan los nanosegundos como decimales
+            length = std::snprintf(line, sizeof(line),
+                "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu.%03llu,\"dur\":%llu.%03llu}",
+                separator, event.name, event.threadId,
+                static_cast<unsigned long long>(event.startNs / 1000),
+                static_cast<unsigned long long>(event.startNs % 1000),
+                static_cast<unsigned long long>(event.durationNs / 1000),
+                static_cast<unsigned long long>(event.durationNs % 1000));
+        }
+
+        if (length > 0) {
+            file.write(line, std::min<int>(length, sizeof(line) - 1));
+            firstEvent = false;
+            eventsWritten++;
+        }
+    }
+
+    file.flush();
+}
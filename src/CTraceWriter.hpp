@@ -0,0 +1,121 @@
+#ifndef CTRACEWRITER_HPP
+#define CTRACEWRITER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Evento completo de una zona ("ph":"X" = inicio + duración) o nombre de un hilo ("ph":"M")
+struct TraceEvent {
+    const char* name;          // Literal estático: no se copia
+    uint64_t startNs;          // Desde el inicio de la traza
+    uint64_t durationNs;
+    uint32_t threadId;
+    char phase;                // 'X' o 'M'
+};
+
+// ===============================================
+// Exportación de trazas en formato Chrome Trace Event
+// ===============================================
+// El archivo se abre en chrome://tracing o ui.perfetto.dev. Registrar un evento
+// solo añade un elemento a un buffer en memoria; un hilo en segundo plano
+// intercambia el buffer y formatea/escribe el JSON, así el disco nunca bloquea
+// el frame que se está midiendo. Cada hilo puede ponerse nombre con
+// setThreadName(); el nombre se escribe una vez por traza, aunque el hilo se
+// haya nombrado antes de start().
+class CTraceWriter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t FLUSH_THRESHOLD = 8192;   // Eventos pendientes que fuerzan un volcado
+    static constexpr int FLUSH_INTERVAL_MS = 100;
+
+private:
+    std::atomic<bool> active;
+    Clock::time_point origin;
+    std::ofstream file;
+    std::string path;
+
+    std::mutex mutex;
+    std::condition_variable flushSignal;
+    std::vector<TraceEvent> pending;               // Protegido por mutex
+    bool stopRequested;
+    std::thread flushThread;
+
+    // Solo lo usa el hilo de volcado
+    std::vector<TraceEvent> writing;
+    bool firstEvent;
+    size_t eventsWritten;
+
+    std::atomic<uint32_t> nextThreadId;
+    std::atomic<uint32_t> session;                 // Se incrementa en cada start()
+
+    CTraceWriter();
+
+public:
+    CTraceWriter(const CTraceWriter&) = delete;
+    CTraceWriter& operator=(const CTraceWriter&) = delete;
+    ~CTraceWriter();
+
+    static CTraceWriter& getInstance() {
+        static CTraceWriter instance;
+        return instance;
+    }
+
+    // Control
+    bool start(const std::string& outputPath);
+    void stop();                                   // Vuelca lo pendiente y cierra el JSON
+    bool isActive() const { return active.load(std::memory_order_relaxed); }
+
+    // Registro (cualquier hilo)
+    void record(const char* name, Clock::time_point begin, Clock::time_point end);
+    void setThreadName(const char* name);          // Literal estático; nombre del hilo que llama
+    uint32_t getCurrentThreadId();
+
+private:
+    void flushLoop();
+    void writeEvents(const std::vector<TraceEvent>& events);
+    void push(const TraceEvent& event);
+    void recordThreadName();
+};
+
+// Zona de traza con ámbito (para funciones fuera del bucle principal)
+class CTraceScope {
+private:
+    const char* name;
+    bool active;
+    CTraceWriter::Clock::time_point begin;
+
+public:
+    explicit CTraceScope(const char* name)
+        : name(name), active(CTraceWriter::getInstance().isActive()) {
+        if (active) {
+            begin = CTraceWriter::Clock::now();
+        }
+    }
+
+    ~CTraceScope() {
+        if (active) {
+            CTraceWriter::getInstance().record(name, begin, CTraceWriter::Clock::now());
+        }
+    }
+
+    CTraceScope(const CTraceScope&) = delete;
+    CTraceScope& operator=(const CTraceScope&) = delete;
+};
+
+#ifdef NO_PROFILER
+#define TRACE_SCOPE(name)
+#else
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) CTraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#endif
+
+#endif // CTRACEWRITER_HPP
@@ -1,19 +1,120 @@
 
 #include <iostream>
 #include <exception>
+#include <string>
+#include <cstdlib>
 #include "CGame.hpp"
+#include "CInputScript.hpp"
+#include "CProfiler.hpp"
+#include "CTraceWriter.hpp"
+#include "CLevelFile.hpp"
 
-int main() {
+// Uso: ./castelvania [--headless] [--ticks N] [--script archivo]
+//                     [--record archivo] [--replay archivo] [--seed N] [--profile]
+//                     [--trace archivo.json] [--atlas-dump prefijo]
+//        ./castelvania --compile-level nivel.txt nivel.cvl
+int main(int argc, char* argv[]) {
+    bool headless = false;
+    long maxTicks = -1;
+    std::string scriptPath;
+    std::string recordPath;
+    std::string replayPath;
+    long seed = -1;
+    std::string tracePath;
+    std::string atlasDumpPrefix;
+    std::string levelSource;
+    std::string levelOutput;
+    
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--ticks" && i + 1 < argc) {
+            maxTicks = std::atol(argv[++i]);
+        } else if (arg == "--script" && i + 1 < argc) {
+            scriptPath = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::atol(argv[++i]);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (arg == "--atlas-dump" && i + 1 < argc) {
+            atlasDumpPrefix = argv[++i];
+        } else if (arg == "--compile-level" && i + 2 < argc) {
+            levelSource = argv[++i];
+            levelOutput = argv[++i];
+        } else if (arg == "--profile") {
+            CProfiler::getInstance().setEnabled(true);
+        } else {
+            std::cerr << "Argumento desconocido: " << arg << std::endl;
+            std::cerr << "Uso: " << argv[0] << " [--headless] [--ticks N] [--script archivo]"
+                      << " [--record archivo] [--replay archivo] [--seed N] [--profile]"
+                      << " [--trace archivo.json] [--atlas-dump prefijo]" << std::endl;
+            std::cerr << "     " << argv[0] << " --compile-level nivel.txt nivel.cvl" << std::endl;
+            return -1;
+        }
+    }
+    
+    // Compilar un nivel de texto al formato binario y salir (make levels)
+    if (!levelSource.empty()) {
+        CLevelFile level;
+        if (!level.loadText(levelSource) || !level.saveBinary(levelOutput)) {
+            std::cerr << "No se pudo compilar " << levelSource << std::endl;
+            return -1;
+        }
+        std::cout << levelSource << " -> " << levelOutput << std::endl;
+        return 0;
+    }
+    
     try {
+        // La traza se cierra al destruirse el singleton aunque la partida salga por excepcion
+        if (!tracePath.empty() && !CTraceWriter::getInstance().start(tracePath)) {
+            return -1;
+        }
+        
+        CGame game;
+        
+        if (seed >= 0) {
+            game.setRandomSeed(static_cast<uint32_t>(seed));
+        }
+        if (!replayPath.empty() && !game.loadReplay(replayPath)) {
+            return -1;
+        }
+        if (!recordPath.empty()) {
+            game.startRecording(recordPath);
+        }
+        if (!atlasDumpPrefix.empty()) {
+            game.setAtlasDumpPrefix(atlasDumpPrefix);
+        }
+        
+        if (headless) {
+            std::cout << "=== Castelvania (headless) ===" << std::endl;
+            
+            CInputScript script;
+            if (!scriptPath.empty() && !script.loadFromFile(scriptPath)) {
+                return -1;
+            }
+            
+            // Un replay se reproduce entero salvo que se indique --ticks
+            if (maxTicks < 0) {
+                maxTicks = replayPath.empty() ? 3600 : game.getReplayLength();
+            }
+            
+            game.runHeadless(script, maxTicks);
+            CTraceWriter::getInstance().stop();
+            return game.hasReplayDiverged() ? 1 : 0;
+        }
+        
         std::cout << "=== Inicializando Castelvania ===" << std::endl;
         std::cout << "Controles: A/D = Mover, W/Espacio = Saltar, Enter = Atacar" << std::endl;
         std::cout << "=================================" << std::endl;
         
-        // Crear el objeto del juego
-        CGame game;
-        
         // Ejecutar el juego principal
         game.run();
+        CTraceWriter::getInstance().stop();
         
         std::cout << "=== Castelvania cerrado ===" << std::endl;
         